@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/mutex.h"
@@ -402,6 +403,297 @@ QueuingAudioStream *makeQueuingAudioStream(int rate, bool stereo) {
 	return new QueuingAudioStreamImpl(rate, stereo);
 }
 
+class PooledQueuingAudioStream : public QueuingAudioStream {
+private:
+	/**
+	 * A queued packet. This is either a queued audio stream, or raw data
+	 * copied into one of the pool blocks.
+	 */
+	struct Packet {
+		AudioStream *_stream;
+		DisposeAfterUse::Flag _disposeAfterUse;
+
+		byte *_block;
+		uint32 _size;
+		uint32 _pos;
+		byte _flags;
+	};
+
+	const int _rate;
+	const bool _stereo;
+	const uint32 _blockSize;
+	bool _finished;
+
+	Common::Mutex _mutex;
+
+	/**
+	 * The queued packets, in a ring buffer starting at _head. It only
+	 * grows when more than its size of packets are waiting to be played.
+	 */
+	Common::Array<Packet> _packets;
+	uint _head;
+	uint _count;
+
+	/** Pool blocks not in use by any queued packet. */
+	Common::Array<byte *> _freeBlocks;
+	/** All pool blocks, for freeing them. */
+	Common::Array<byte *> _blocks;
+
+	Packet &front() { return _packets[_head]; }
+	void push(const Packet &packet);
+	void pop();
+
+	static int bytesPerSample(byte flags);
+	static void convert(int16 *dst, const byte *src, int samples, byte flags);
+
+public:
+	PooledQueuingAudioStream(int rate, bool stereo, uint32 blockSize, uint numBlocks);
+	~PooledQueuingAudioStream();
+
+	// Implement the AudioStream API
+	virtual int readBuffer(int16 *buffer, const int numSamples);
+	virtual bool isStereo() const { return _stereo; }
+	virtual int getRate() const { return _rate; }
+
+	virtual bool endOfData() const {
+		Common::StackLock lock(_mutex);
+		if (!_count)
+			return true;
+
+		const Packet &packet = _packets[_head];
+		return packet._stream && packet._stream->endOfData();
+	}
+
+	virtual bool endOfStream() const {
+		Common::StackLock lock(_mutex);
+		return _finished && !_count;
+	}
+
+	// Implement the QueuingAudioStream API
+	virtual void queueAudioStream(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+	virtual void queueBuffer(byte *data, uint32 size, DisposeAfterUse::Flag disposeAfterUse, byte flags);
+
+	virtual void finish() {
+		Common::StackLock lock(_mutex);
+		_finished = true;
+	}
+
+	uint32 numQueuedStreams() const {
+		Common::StackLock lock(_mutex);
+		return _count;
+	}
+};
+
+PooledQueuingAudioStream::PooledQueuingAudioStream(int rate, bool stereo, uint32 blockSize, uint numBlocks)
+	: _rate(rate), _stereo(stereo), _blockSize(blockSize), _finished(false), _head(0), _count(0) {
+	assert(blockSize > 0);
+
+	_packets.resize(MAX<uint>(numBlocks, 1));
+	_freeBlocks.reserve(numBlocks);
+	_blocks.reserve(numBlocks);
+
+	for (uint i = 0; i < numBlocks; i++) {
+		byte *block = new byte[blockSize];
+		_blocks.push_back(block);
+		_freeBlocks.push_back(block);
+	}
+}
+
+PooledQueuingAudioStream::~PooledQueuingAudioStream() {
+	while (_count)
+		pop();
+
+	for (uint i = 0; i < _blocks.size(); i++)
+		delete[] _blocks[i];
+}
+
+void PooledQueuingAudioStream::push(const Packet &packet) {
+	if (_count == _packets.size()) {
+		// Grow the ring, moving the packets to its start
+		Common::Array<Packet> packets;
+		packets.resize(_packets.size() * 2);
+		for (uint i = 0; i < _count; i++)
+			packets[i] = _packets[(_head + i) % _packets.size()];
+
+		_packets = packets;
+		_head = 0;
+		debug(5, "PooledQueuingAudioStream: Grew packet ring to %d entries", _packets.size());
+	}
+
+	_packets[(_head + _count) % _packets.size()] = packet;
+	_count++;
+}
+
+void PooledQueuingAudioStream::pop() {
+	Packet &packet = front();
+
+	if (packet._stream) {
+		if (packet._disposeAfterUse == DisposeAfterUse::YES)
+			delete packet._stream;
+	} else {
+		_freeBlocks.push_back(packet._block);
+	}
+
+	_head = (_head + 1) % _packets.size();
+	_count--;
+}
+
+int PooledQueuingAudioStream::bytesPerSample(byte flags) {
+	if (flags & FLAG_24BITS)
+		return 3;
+	if (flags & FLAG_16BITS)
+		return 2;
+	return 1;
+}
+
+/**
+ * Convert raw samples to the mixer format, as RawStream does. The format is
+ * a template parameter, so that the loop does not check it for each sample.
+ */
+template<int bytesPerSample, bool isUnsigned, bool isLE>
+static void convertRawSamples(int16 *dst, const byte *src, int samples) {
+	while (samples-- > 0) {
+		if (bytesPerSample == 1)
+			*dst++ = (*src << 8) ^ (isUnsigned ? 0x8000 : 0);
+		else if (bytesPerSample == 2)
+			*dst++ = ((isLE ? READ_LE_UINT16(src) : READ_BE_UINT16(src)) ^ (isUnsigned ? 0x8000 : 0));
+		else // if (bytesPerSample == 3)
+			*dst++ = (((int16)((isLE ? READ_LE_UINT24(src) : READ_BE_UINT24(src)) >> 8)) ^ (isUnsigned ? 0x8000 : 0));
+
+		src += bytesPerSample;
+	}
+}
+
+#define CONVERT_ENDIAN(bytesPerSample, isUnsigned) \
+		if (flags & FLAG_LITTLE_ENDIAN) \
+			convertRawSamples<bytesPerSample, isUnsigned, true>(dst, src, samples); \
+		else \
+			convertRawSamples<bytesPerSample, isUnsigned, false>(dst, src, samples)
+
+#define CONVERT(bytesPerSample) \
+		if (flags & FLAG_UNSIGNED) { \
+			CONVERT_ENDIAN(bytesPerSample, true); \
+		} else { \
+			CONVERT_ENDIAN(bytesPerSample, false); \
+		}
+
+void PooledQueuingAudioStream::convert(int16 *dst, const byte *src, int samples, byte flags) {
+	switch (bytesPerSample(flags)) {
+	case 1:
+		// Endianness does not matter for 8 bit samples
+		if (flags & FLAG_UNSIGNED)
+			convertRawSamples<1, true, false>(dst, src, samples);
+		else
+			convertRawSamples<1, false, false>(dst, src, samples);
+		break;
+	case 2:
+		CONVERT(2);
+		break;
+	default:
+		CONVERT(3);
+		break;
+	}
+}
+
+#undef CONVERT
+#undef CONVERT_ENDIAN
+
+void PooledQueuingAudioStream::queueAudioStream(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	assert(!_finished);
+	if ((stream->getRate() != getRate()) || (stream->isStereo() != isStereo()))
+		error("PooledQueuingAudioStream::queueAudioStream: stream has mismatched parameters");
+
+	Packet packet;
+	packet._stream = stream;
+	packet._disposeAfterUse = disposeAfterUse;
+	packet._block = nullptr;
+	packet._size = packet._pos = 0;
+	packet._flags = 0;
+
+	Common::StackLock lock(_mutex);
+	push(packet);
+}
+
+void PooledQueuingAudioStream::queueBuffer(byte *data, uint32 size, DisposeAfterUse::Flag disposeAfterUse, byte flags) {
+	assert(!_finished);
+	if (((flags & FLAG_STEREO) != 0) != isStereo())
+		error("PooledQueuingAudioStream::queueBuffer: buffer has mismatched parameters");
+
+	// Only split the data at whole sample frames
+	const uint32 frameSize = bytesPerSample(flags) * (isStereo() ? 2 : 1);
+	const uint32 chunkSize = _blockSize - _blockSize % frameSize;
+	assert(chunkSize > 0);
+
+	size -= size % frameSize;
+
+	Common::StackLock lock(_mutex);
+
+	for (uint32 offset = 0; offset < size; offset += chunkSize) {
+		if (_freeBlocks.empty()) {
+			byte *block = new byte[_blockSize];
+			_blocks.push_back(block);
+			_freeBlocks.push_back(block);
+			debug(5, "PooledQueuingAudioStream: Grew pool to %d blocks", _blocks.size());
+		}
+
+		Packet packet;
+		packet._stream = nullptr;
+		packet._disposeAfterUse = DisposeAfterUse::NO;
+		packet._block = _freeBlocks.back();
+		packet._size = MIN(chunkSize, size - offset);
+		packet._pos = 0;
+		packet._flags = flags;
+		_freeBlocks.pop_back();
+
+		memcpy(packet._block, data + offset, packet._size);
+		push(packet);
+	}
+
+	if (disposeAfterUse == DisposeAfterUse::YES)
+		free(data);
+}
+
+int PooledQueuingAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	Common::StackLock lock(_mutex);
+	int samplesDecoded = 0;
+
+	while (samplesDecoded < numSamples && _count) {
+		Packet &packet = front();
+
+		if (!packet._stream) {
+			const int bps = bytesPerSample(packet._flags);
+			const int samples = MIN<int>(numSamples - samplesDecoded, (packet._size - packet._pos) / bps);
+
+			convert(buffer + samplesDecoded, packet._block + packet._pos, samples, packet._flags);
+			samplesDecoded += samples;
+			packet._pos += samples * bps;
+
+			if (packet._pos >= packet._size)
+				pop();
+			continue;
+		}
+
+		AudioStream *stream = packet._stream;
+		samplesDecoded += stream->readBuffer(buffer + samplesDecoded, numSamples - samplesDecoded);
+
+		// Done with the stream completely
+		if (stream->endOfStream()) {
+			pop();
+			continue;
+		}
+
+		// Done with data but not the stream, bail out
+		if (stream->endOfData())
+			break;
+	}
+
+	return samplesDecoded;
+}
+
+QueuingAudioStream *makePooledQueuingAudioStream(int rate, bool stereo, uint32 blockSize, uint numBlocks) {
+	return new PooledQueuingAudioStream(rate, stereo, blockSize, numBlocks);
+}
+
 Timestamp convertTimeToStreamPos(const Timestamp &where, int rate, bool isStereo) {
 	Timestamp result(where.convertToFramerate(rate * (isStereo ? 2 : 1)));
 
@@ -362,7 +362,7 @@ public:
 	 * @param disposeAfterUse  If equal to DisposeAfterUse::YES, the block is released using free() after use.
 	 * @param flags            A bit-ORed combination of RawFlags describing the audio data format.
 	 */
-	void queueBuffer(byte *data, uint32 size, DisposeAfterUse::Flag disposeAfterUse, byte flags);
+	virtual void queueBuffer(byte *data, uint32 size, DisposeAfterUse::Flag disposeAfterUse, byte flags);
 
 	/**
 	 * Mark this stream as finished.
@@ -384,6 +384,25 @@ public:
  */
 QueuingAudioStream *makeQueuingAudioStream(int rate, bool stereo);
 
+/**
+ * Factory function for a QueuingAudioStream which copies the data passed
+ * to queueBuffer() into a pool of reusable blocks.
+ *
+ * Once the pool holds enough blocks for the data waiting to be played, queuing
+ * a buffer does not allocate any memory. Since the data is copied, callers
+ * can pass the same buffer over and over with DisposeAfterUse::NO. This
+ * suits video decoders and streaming sound code which queue many small
+ * packets per second. Streams queued with queueAudioStream() are played
+ * in order with the pooled data, as usual.
+ *
+ * @param rate       Rate of the stream.
+ * @param stereo     Whether the stream is a stereo stream.
+ * @param blockSize  Size of each block in bytes. Larger buffers are split.
+ * @param numBlocks  Number of blocks to allocate up front. The pool grows
+ *                   when more data is waiting to be played.
+ */
+QueuingAudioStream *makePooledQueuingAudioStream(int rate, bool stereo, uint32 blockSize, uint numBlocks);
+
 /**
  * Convert a point in time to a precise sample offset
  * with the given parameters.
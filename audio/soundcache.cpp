@@ -0,0 +1,259 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/array.h"
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/util.h"
+
+#include "audio/audiostream.h"
+#include "audio/soundcache.h"
+
+namespace Audio {
+
+/**
+ * State shared by the cache and all its entries. Streams may outlive the
+ * cache, so this is only deleted once both the cache and the last entry
+ * are gone.
+ */
+struct SoundCache::State {
+	Common::Mutex mutex;
+	/** Number of entries alive, whether cached or only read by streams. */
+	uint numEntries;
+	/** Whether the cache has been deleted. */
+	bool detached;
+
+	State() : numEntries(0), detached(false) {}
+};
+
+struct SoundCache::Entry {
+	Key key;
+	State *state;
+
+	int16 *data;
+	uint32 numSamples;
+	int rate;
+	bool stereo;
+
+	/** Number of streams reading the sound. */
+	uint refCount;
+	/** Whether the sound is still in the cache, and in _lru. */
+	bool cached;
+	EntryList::iterator lruPos;
+
+	Entry(const Key &k, State *s) : key(k), state(s), data(nullptr), numSamples(0), rate(0), stereo(false), refCount(0), cached(false) {}
+	~Entry() { delete[] data; }
+
+	uint32 getSize() const { return numSamples * sizeof(int16); }
+};
+
+/**
+ * A stream reading a cached sound. Any number of these can share
+ * the same entry, each one with its own position.
+ */
+class SoundCache::CachedStream : public SeekableAudioStream {
+public:
+	CachedStream(Entry *entry) : _entry(entry), _pos(0) {}
+
+	~CachedStream() {
+		SoundCache::release(_entry);
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) {
+		const int samples = MIN<uint32>(numSamples, _entry->numSamples - _pos);
+		memcpy(buffer, _entry->data + _pos, samples * sizeof(int16));
+		_pos += samples;
+		return samples;
+	}
+
+	bool isStereo() const { return _entry->stereo; }
+	int getRate() const { return _entry->rate; }
+	bool endOfData() const { return _pos >= _entry->numSamples; }
+
+	bool seek(const Timestamp &where) {
+		const uint32 pos = convertTimeToStreamPos(where, getRate(), isStereo()).totalNumberOfFrames();
+		if (pos > _entry->numSamples)
+			return false;
+
+		_pos = pos;
+		return true;
+	}
+
+	Timestamp getLength() const {
+		return Timestamp(0, _entry->numSamples / (_entry->stereo ? 2 : 1), _entry->rate);
+	}
+
+private:
+	Entry *_entry;
+	uint32 _pos;
+};
+
+uint SoundCache::Key_Hash::operator()(const Key &key) const {
+	return (Common::hashit_lower(key.archive) * 31 + Common::hashit_lower(key.member)) * 31 + key.offset;
+}
+
+bool SoundCache::Key_EqualTo::operator()(const Key &a, const Key &b) const {
+	return a.offset == b.offset && a.member.equalsIgnoreCase(b.member) && a.archive.equalsIgnoreCase(b.archive);
+}
+
+SoundCache::SoundCache(uint32 budget) : _state(new State()), _budget(budget), _size(0), _hits(0), _misses(0) {
+}
+
+SoundCache::~SoundCache() {
+	bool deleteState;
+	{
+		Common::StackLock lock(_state->mutex);
+
+		// Streams still alive free their sound themselves, including the
+		// ones reading sounds which were already dropped
+		while (!_lru.empty())
+			drop(_lru.back());
+
+		_state->detached = true;
+		deleteState = _state->numEntries == 0;
+	}
+
+	if (deleteState)
+		delete _state;
+}
+
+SeekableAudioStream *SoundCache::get(const Common::String &archive, const Common::String &member, uint32 offset) {
+	Common::StackLock lock(_state->mutex);
+
+	EntryMap::iterator i = _entries.find(Key(archive, member, offset));
+	if (i == _entries.end()) {
+		_misses++;
+		return nullptr;
+	}
+
+	_hits++;
+
+	Entry *entry = i->_value;
+	_lru.erase(entry->lruPos);
+	_lru.push_front(entry);
+	entry->lruPos = _lru.begin();
+
+	entry->refCount++;
+	return new CachedStream(entry);
+}
+
+SeekableAudioStream *SoundCache::add(const Common::String &archive, const Common::String &member, uint32 offset, SeekableAudioStream *stream) {
+	if (!stream)
+		return nullptr;
+
+	// Decode the whole sound without holding the lock
+	Common::Array<int16> samples;
+
+	const int channels = stream->isStereo() ? 2 : 1;
+	const uint32 length = stream->getLength().convertToFramerate(stream->getRate()).totalNumberOfFrames();
+	samples.reserve(length * channels);
+
+	const int kChunkSize = 2048;
+	while (!stream->endOfData()) {
+		const uint32 pos = samples.size();
+		samples.resize(pos + kChunkSize);
+
+		const int read = stream->readBuffer(&samples[pos], kChunkSize);
+		samples.resize(pos + MAX(read, 0));
+
+		if (read <= 0)
+			break;
+	}
+
+	Entry *entry = new Entry(Key(archive, member, offset), _state);
+	entry->numSamples = samples.size();
+	entry->rate = stream->getRate();
+	entry->stereo = stream->isStereo();
+	entry->data = new int16[MAX<uint32>(entry->numSamples, 1)];
+	if (entry->numSamples)
+		memcpy(entry->data, &samples[0], entry->getSize());
+	entry->refCount = 1;
+
+	delete stream;
+
+	Common::StackLock lock(_state->mutex);
+	_state->numEntries++;
+
+	EntryMap::iterator i = _entries.find(entry->key);
+	if (i != _entries.end())
+		drop(i->_value);
+
+	if (entry->getSize() <= _budget) {
+		trim(_budget - entry->getSize());
+
+		_entries[entry->key] = entry;
+		_lru.push_front(entry);
+		entry->lruPos = _lru.begin();
+		entry->cached = true;
+		_size += entry->getSize();
+	}
+
+	return new CachedStream(entry);
+}
+
+void SoundCache::clear() {
+	Common::StackLock lock(_state->mutex);
+	trim(0);
+}
+
+void SoundCache::setBudget(uint32 budget) {
+	Common::StackLock lock(_state->mutex);
+	_budget = budget;
+	trim(budget);
+}
+
+void SoundCache::release(Entry *entry) {
+	// This may run on the audio thread after the cache has been deleted,
+	// so only the shared state may be used
+	State *state = entry->state;
+	bool deleteState = false;
+	{
+		Common::StackLock lock(state->mutex);
+
+		if (--entry->refCount == 0 && !entry->cached) {
+			delete entry;
+			deleteState = --state->numEntries == 0 && state->detached;
+		}
+	}
+
+	if (deleteState)
+		delete state;
+}
+
+void SoundCache::drop(Entry *entry) {
+	_entries.erase(entry->key);
+	_lru.erase(entry->lruPos);
+	_size -= entry->getSize();
+	entry->cached = false;
+
+	if (entry->refCount == 0) {
+		delete entry;
+		_state->numEntries--;
+	}
+}
+
+void SoundCache::trim(uint32 budget) {
+	while (_size > budget && !_lru.empty())
+		drop(_lru.back());
+}
+
+} // End of namespace Audio
@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_SOUNDCACHE_H
+#define AUDIO_SOUNDCACHE_H
+
+#include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/str.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_soundcache Sound cache
+ * @ingroup audio
+ *
+ * @brief Cache of decoded sounds for effects that are played over and over.
+ * @{
+ */
+
+class SeekableAudioStream;
+
+/**
+ * A memory-budgeted cache of fully decoded sounds.
+ *
+ * Engines that play the same compressed effect many times can decode it
+ * once through the cache, and then create any number of streams reading
+ * from the shared PCM data without decoding it again. Sounds are
+ * identified by the archive and member they were loaded from and their
+ * offset inside it.
+ *
+ * When the budget is exceeded the least recently used sounds are dropped.
+ * Sounds which are still being played stay alive until their last stream
+ * has been deleted. Streams may outlive the cache, so the mixer can still
+ * be playing them when the cache is deleted.
+ *
+ * Usage:
+ * @code
+ * Audio::SeekableAudioStream *stream = cache.get(archive, member, offset);
+ * if (!stream)
+ *     stream = cache.add(archive, member, offset, Audio::makeVOCStream(...));
+ * @endcode
+ */
+class SoundCache {
+public:
+	/** The default memory budget, in bytes. */
+	static const uint32 kDefaultBudget = 8 * 1024 * 1024;
+
+	explicit SoundCache(uint32 budget = kDefaultBudget);
+	~SoundCache();
+
+	/**
+	 * Create a new stream reading a cached sound.
+	 *
+	 * @return The stream, or nullptr if the sound is not cached.
+	 */
+	SeekableAudioStream *get(const Common::String &archive, const Common::String &member, uint32 offset = 0);
+
+	/**
+	 * Decode a sound completely and add it to the cache.
+	 *
+	 * Sounds larger than the whole budget are still decoded, but are
+	 * freed again as soon as the returned stream is deleted.
+	 *
+	 * @param stream The stream to decode, which is deleted afterwards.
+	 * @return A stream reading the decoded sound, or nullptr if stream
+	 *         was nullptr.
+	 */
+	SeekableAudioStream *add(const Common::String &archive, const Common::String &member, uint32 offset, SeekableAudioStream *stream);
+
+	/** Drop all sounds not currently being played. */
+	void clear();
+
+	/** Change the memory budget, dropping sounds if needed. */
+	void setBudget(uint32 budget);
+	uint32 getBudget() const { return _budget; }
+
+	/** Return the memory used by the cached sounds, in bytes. */
+	uint32 getSize() const { return _size; }
+
+	/** Return the number of get() calls which found their sound. */
+	uint32 getHits() const { return _hits; }
+
+	/** Return the number of get() calls which did not find their sound. */
+	uint32 getMisses() const { return _misses; }
+
+	void resetStats() { _hits = _misses = 0; }
+
+private:
+	struct Key {
+		Common::String archive;
+		Common::String member;
+		uint32 offset;
+
+		Key(const Common::String &a, const Common::String &m, uint32 o) : archive(a), member(m), offset(o) {}
+	};
+
+	struct Key_Hash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Key_EqualTo {
+		bool operator()(const Key &a, const Key &b) const;
+	};
+
+	struct State;
+	struct Entry;
+	class CachedStream;
+
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Key, Entry *, Key_Hash, Key_EqualTo> EntryMap;
+
+	static void release(Entry *entry);
+	void drop(Entry *entry);
+	void trim(uint32 budget);
+
+	EntryMap _entries;
+	/** Cached sounds, most recently used first. */
+	EntryList _lru;
+	/** Lock and entry count, shared with the streams. */
+	State *_state;
+
+	uint32 _budget;
+	uint32 _size;
+	uint32 _hits;
+	uint32 _misses;
+};
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
@@ -173,6 +173,15 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Gets the size and the time of the last modification of the file
+	 * referred by this node.
+	 *
+	 * @param size size of the file in bytes
+	 * @param modificationTime time of the last modification, in seconds
+	 * @return true if successful, false if this is not supported or failed
+	 */
+	virtual bool getFileInfo(uint32 &size, uint32 &modificationTime) const { return false; }
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -35,9 +35,13 @@
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
 #include "common/algorithm.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #ifdef MACOSX
 #include <sys/types.h>
 #endif
@@ -59,7 +63,171 @@
 #include "backends/platform/android/jni-android.h"
 #endif
 
+namespace Posix {
+
+/**
+ * Cache of directory listings and stat() results, enabled with
+ * setFilesystemCacheTTL(). Entries expire after the configured time, and
+ * expired entries are pruned whenever that time has passed again.
+ *
+ * Nodes may be used from several threads, so all accesses are locked.
+ */
+class FilesystemCache {
+public:
+	struct Flags {
+		bool isValid;
+		bool isDirectory;
+	};
+
+	struct DirEntry {
+		Common::String name;
+		bool isDirectory;
+	};
+
+	typedef Common::Array<DirEntry> DirEntryList;
+
+	FilesystemCache(uint32 ttl) : _ttl(ttl), _lastPrune(getMillis()), _statsSaved(0), _listingsSaved(0) {}
+
+	void setTTL(uint32 ttl) {
+		Common::StackLock lock(_mutex);
+		_ttl = ttl;
+	}
+
+	bool getFlags(const Common::String &path, Flags &flags) {
+		Common::StackLock lock(_mutex);
+		FlagsMap::const_iterator i = _flags.find(path);
+		if (i == _flags.end() || isExpired(i->_value.time))
+			return false;
+
+		flags = i->_value.flags;
+		++_statsSaved;
+		return true;
+	}
+
+	void setFlags(const Common::String &path, const Flags &flags) {
+		Common::StackLock lock(_mutex);
+		pruneExpired();
+		CachedFlags &entry = _flags[path];
+		entry.time = getMillis();
+		entry.flags = flags;
+	}
+
+	bool getListing(const Common::String &path, DirEntryList &entries) {
+		Common::StackLock lock(_mutex);
+		ListingMap::const_iterator i = _listings.find(path);
+		if (i == _listings.end() || isExpired(i->_value.time))
+			return false;
+
+		++_listingsSaved;
+		entries = i->_value.entries;
+		return true;
+	}
+
+	void setListing(const Common::String &path, const DirEntryList &entries) {
+		Common::StackLock lock(_mutex);
+		pruneExpired();
+		const uint32 time = getMillis();
+		CachedListing &listing = _listings[path];
+		listing.time = time;
+		listing.entries = entries;
+
+		// Remember the type of the children as well, to avoid stat() calls
+		// when nodes are created for them.
+		Common::String childPath(path);
+		if (childPath.lastChar() != '/')
+			childPath += '/';
+		for (DirEntryList::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+			CachedFlags &entry = _flags[childPath + i->name];
+			entry.time = time;
+			entry.flags.isValid = true;
+			entry.flags.isDirectory = i->isDirectory;
+		}
+	}
+
+	void invalidate(const Common::String &path) {
+		Common::StackLock lock(_mutex);
+		_flags.erase(path);
+		_listings.erase(path);
+
+		const char *start = path.c_str();
+		const char *end = start + path.size();
+		while (end > start && *(end - 1) != '/')
+			end--;
+		if (end > start + 1)
+			end--;
+		_listings.erase(Common::String(start, end));
+	}
+
+	void clear() {
+		Common::StackLock lock(_mutex);
+		_flags.clear();
+		_listings.clear();
+	}
+
+	void getStats(uint32 &statsSaved, uint32 &listingsSaved) {
+		Common::StackLock lock(_mutex);
+		statsSaved = _statsSaved;
+		listingsSaved = _listingsSaved;
+	}
+
+private:
+	struct CachedFlags {
+		uint32 time;
+		Flags flags;
+	};
+
+	struct CachedListing {
+		uint32 time;
+		DirEntryList entries;
+	};
+
+	typedef Common::HashMap<Common::String, CachedFlags> FlagsMap;
+	typedef Common::HashMap<Common::String, CachedListing> ListingMap;
+
+	static uint32 getMillis() {
+		struct timeval tv;
+		gettimeofday(&tv, nullptr);
+		return (uint32)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+	}
+
+	bool isExpired(uint32 time) const {
+		return getMillis() - time >= _ttl;
+	}
+
+	/** Drop the expired entries, at most once per TTL period. */
+	void pruneExpired() {
+		if (!isExpired(_lastPrune))
+			return;
+		_lastPrune = getMillis();
+
+		for (FlagsMap::iterator i = _flags.begin(); i != _flags.end(); ++i) {
+			if (isExpired(i->_value.time))
+				_flags.erase(i);
+		}
+		for (ListingMap::iterator i = _listings.begin(); i != _listings.end(); ++i) {
+			if (isExpired(i->_value.time))
+				_listings.erase(i);
+		}
+	}
+
+	Common::Mutex _mutex;
+	uint32 _ttl;
+	uint32 _lastPrune;
+	FlagsMap _flags;
+	ListingMap _listings;
+	uint32 _statsSaved;
+	uint32 _listingsSaved;
+};
+
+static FilesystemCache *g_filesystemCache = nullptr;
+
+} // End of namespace Posix
+
 bool POSIXFilesystemNode::exists() const {
+	Posix::FilesystemCache::Flags flags;
+	if (Posix::g_filesystemCache && Posix::g_filesystemCache->getFlags(_path, flags))
+		return flags.isValid;
+
 	return access(_path.c_str(), F_OK) == 0;
 }
 
@@ -71,11 +239,34 @@ bool POSIXFilesystemNode::isWritable() const {
 	return access(_path.c_str(), W_OK) == 0;
 }
 
+bool POSIXFilesystemNode::getFileInfo(uint32 &size, uint32 &modificationTime) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0)
+		return false;
+
+	size = (uint32)st.st_size;
+	modificationTime = (uint32)st.st_mtime;
+	return true;
+}
+
 void POSIXFilesystemNode::setFlags() {
+	Posix::FilesystemCache::Flags flags;
+	if (Posix::g_filesystemCache && Posix::g_filesystemCache->getFlags(_path, flags)) {
+		_isValid = flags.isValid;
+		_isDirectory = flags.isDirectory;
+		return;
+	}
+
 	struct stat st;
 
 	_isValid = (0 == stat(_path.c_str(), &st));
 	_isDirectory = _isValid ? S_ISDIR(st.st_mode) : false;
+
+	if (Posix::g_filesystemCache) {
+		flags.isValid = _isValid;
+		flags.isDirectory = _isDirectory;
+		Posix::g_filesystemCache->setFlags(_path, flags);
+	}
 }
 
 POSIXFilesystemNode::POSIXFilesystemNode(const Common::String &p) {
@@ -189,6 +380,30 @@ bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, boo
 	}
 #endif
 
+	Posix::FilesystemCache::DirEntryList entries;
+
+	if (Posix::g_filesystemCache && Posix::g_filesystemCache->getListing(_path, entries)) {
+		for (Posix::FilesystemCache::DirEntryList::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+			if (i->name[0] == '.' && !hidden)
+				continue;
+
+			if ((mode == Common::FSNode::kListFilesOnly && i->isDirectory) ||
+				(mode == Common::FSNode::kListDirectoriesOnly && !i->isDirectory))
+				continue;
+
+			POSIXFilesystemNode *entry = new POSIXFilesystemNode(*this);
+			entry->_displayName = i->name;
+			if (_path.lastChar() != '/')
+				entry->_path += '/';
+			entry->_path += entry->_displayName;
+			entry->_isValid = true;
+			entry->_isDirectory = i->isDirectory;
+			myList.push_back(entry);
+		}
+
+		return true;
+	}
+
 	DIR *dirp = opendir(_path.c_str());
 	struct dirent *dp;
 
@@ -197,8 +412,8 @@ bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, boo
 
 	// loop over dir entries using readdir
 	while ((dp = readdir(dirp)) != NULL) {
-		// Skip 'invisible' files if necessary
-		if (dp->d_name[0] == '.' && !hidden) {
+		// Skip 'invisible' files if necessary, unless the listing is cached
+		if (dp->d_name[0] == '.' && !hidden && !Posix::g_filesystemCache) {
 			continue;
 		}
 		// Skip '.' and '..' to avoid cycles
@@ -245,6 +460,18 @@ bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, boo
 		if (!entry._isValid)
 			continue;
 
+		// The listing is cached unfiltered, so that it can be reused for all modes
+		if (Posix::g_filesystemCache) {
+			Posix::FilesystemCache::DirEntry cacheEntry;
+			cacheEntry.name = entry._displayName;
+			cacheEntry.isDirectory = entry._isDirectory;
+			entries.push_back(cacheEntry);
+		}
+
+		// Skip 'invisible' files if necessary
+		if (entry._displayName[0] == '.' && !hidden)
+			continue;
+
 		// Honor the chosen mode
 		if ((mode == Common::FSNode::kListFilesOnly && entry._isDirectory) ||
 			(mode == Common::FSNode::kListDirectoriesOnly && !entry._isDirectory))
@@ -254,6 +481,9 @@ bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, boo
 	}
 	closedir(dirp);
 
+	if (Posix::g_filesystemCache)
+		Posix::g_filesystemCache->setListing(_path, entries);
+
 	return true;
 }
 
@@ -291,10 +521,15 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 }
 
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
+	// The file may be created, which changes the listing of its directory
+	Posix::invalidateFilesystemCache(_path);
+
 	return PosixIoStream::makeFromPath(getPath(), true);
 }
 
 bool POSIXFilesystemNode::createDirectory() {
+	Posix::invalidateFilesystemCache(_path);
+
 	if (mkdir(_path.c_str(), 0755) == 0)
 		setFlags();
 #if defined(ANDROID_PLAIN_PORT)
@@ -373,6 +608,33 @@ bool assureDirectoryExists(const Common::String &dir, const char *prefix) {
 	return true;
 }
 
+void setFilesystemCacheTTL(uint32 ttl) {
+	if (ttl == 0) {
+		delete g_filesystemCache;
+		g_filesystemCache = nullptr;
+	} else if (g_filesystemCache) {
+		g_filesystemCache->setTTL(ttl);
+	} else {
+		g_filesystemCache = new FilesystemCache(ttl);
+	}
+}
+
+void invalidateFilesystemCache(const Common::String &path) {
+	if (g_filesystemCache)
+		g_filesystemCache->invalidate(path);
+}
+
+void clearFilesystemCache() {
+	if (g_filesystemCache)
+		g_filesystemCache->clear();
+}
+
+void getFilesystemCacheStats(uint32 &statsSaved, uint32 &listingsSaved) {
+	statsSaved = listingsSaved = 0;
+	if (g_filesystemCache)
+		g_filesystemCache->getStats(statsSaved, listingsSaved);
+}
+
 } // End of namespace Posix
 
 #endif //#if defined(POSIX)
@@ -61,6 +61,7 @@ public:
 	virtual bool isDirectory() const { return _isDirectory; }
 	virtual bool isReadable() const;
 	virtual bool isWritable() const;
+	virtual bool getFileInfo(uint32 &size, uint32 &modificationTime) const;
 
 	virtual AbstractFSNode *getChild(const Common::String &n) const;
 	virtual bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const;
@@ -89,6 +90,38 @@ namespace Posix {
  */
 bool assureDirectoryExists(const Common::String &dir, const char *prefix = nullptr);
 
+/**
+ * Enable or disable the cache of directory listings and stat() results
+ * shared by all POSIXFilesystemNode instances.
+ *
+ * The cache is disabled by default. It helps when the same directories are
+ * listed repeatedly on slow file systems, such as network mounts, at the cost
+ * of not noticing changes made outside of ScummVM for up to @p ttl
+ * milliseconds.
+ *
+ * @param ttl Time in milliseconds during which cached results are used,
+ *            or 0 to disable the cache.
+ */
+void setFilesystemCacheTTL(uint32 ttl);
+
+/**
+ * Drop the cached listing and stat() result for the given path, and the
+ * listing of its parent directory.
+ */
+void invalidateFilesystemCache(const Common::String &path);
+
+/**
+ * Drop all cached listings and stat() results.
+ */
+void clearFilesystemCache();
+
+/**
+ * Get the number of stat() calls and directory listings which were answered
+ * from the cache.
+ */
+void getFilesystemCacheStats(uint32 &statsSaved, uint32 &listingsSaved);
+
+
 } // End of namespace Posix
 
 #endif
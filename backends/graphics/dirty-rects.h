@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_DIRTY_RECTS_H
+#define BACKENDS_GRAPHICS_DIRTY_RECTS_H
+
+#include "common/util.h"
+
+/*
+ * Helpers for the dirty rect lists of the graphics managers. They work on
+ * any rect type with x, y, w and h members, like SDL_Rect.
+ */
+
+template<typename RectType>
+inline int dirtyRectArea(const RectType &r) {
+	return r.w * r.h;
+}
+
+template<typename RectType>
+RectType dirtyRectUnion(const RectType &r1, const RectType &r2) {
+	int x1 = MIN<int>(r1.x, r2.x);
+	int y1 = MIN<int>(r1.y, r2.y);
+	int x2 = MAX<int>(r1.x + r1.w, r2.x + r2.w);
+	int y2 = MAX<int>(r1.y + r1.h, r2.y + r2.h);
+
+	RectType r;
+	r.x = x1;
+	r.y = y1;
+	r.w = x2 - x1;
+	r.h = y2 - y1;
+	return r;
+}
+
+/**
+ * Add a rect to a list of dirty rects.
+ *
+ * The rect is merged with the rects of the list when updating the area
+ * covering both costs less than updating them separately, each rect costing
+ * rectCost pixels on top of its area. Rects contained in others are dropped
+ * this way. When the list is full, the rect is merged with the one which
+ * grows the least, so the list never overflows.
+ *
+ * @param list      The list of dirty rects.
+ * @param numRects  The number of rects in the list, updated on return.
+ * @param maxRects  The capacity of the list.
+ * @param rectCost  The cost of updating a rect, in pixels.
+ * @param rect      The rect to add, which must not be empty.
+ */
+template<typename RectType>
+void addDirtyRectToList(RectType *list, int &numRects, int maxRects, int rectCost, RectType rect) {
+	while (true) {
+		int i = 0;
+		while (i < numRects) {
+			RectType merged = dirtyRectUnion(list[i], rect);
+			if (dirtyRectArea(merged) <= dirtyRectArea(list[i]) + dirtyRectArea(rect) + rectCost) {
+				// The merged rect may now be worth merging with rects already checked
+				list[i] = list[--numRects];
+				rect = merged;
+				i = 0;
+			} else {
+				++i;
+			}
+		}
+
+		if (numRects < maxRects)
+			break;
+
+		// When out of rects, merge with the one which grows the least. The
+		// result may contain other rects, so check the list again.
+		int best = 0;
+		int bestGrowth = 0;
+		for (i = 0; i < numRects; ++i) {
+			int growth = dirtyRectArea(dirtyRectUnion(list[i], rect)) - dirtyRectArea(list[i]);
+			if (i == 0 || growth < bestGrowth) {
+				best = i;
+				bestGrowth = growth;
+			}
+		}
+		rect = dirtyRectUnion(list[best], rect);
+		list[best] = list[--numRects];
+	}
+
+	list[numRects++] = rect;
+}
+
+#endif
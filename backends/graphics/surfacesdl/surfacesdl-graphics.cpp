@@ -24,8 +24,10 @@
 
 #if defined(SDL_BACKEND)
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
+#include "backends/graphics/dirty-rects.h"
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/mutex.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
@@ -1220,6 +1222,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		srcPitch = srcSurf->pitch;
 		dstPitch = _hwScreen->pitch;
 
+		uint32 scaledPixels = 0;
+
 		for (r = _dirtyRectList; r != lastRect; ++r) {
 			int dst_x = r->x + _currentShakeXOffset;
 			int dst_y = r->y + _currentShakeYOffset;
@@ -1249,6 +1253,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 
 				_scalerPlugin->scale((byte *)srcSurf->pixels + (r->x + _maxExtraPixels) * 2 + (r->y + _maxExtraPixels) * srcPitch, srcPitch,
 					(byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h, r->x, r->y);
+				scaledPixels += r->w * dst_h;
 			}
 
 			r->x = dst_x;
@@ -1264,6 +1269,9 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwScreen);
 
+		debug(9, "SurfaceSdlGraphicsManager: Scaled %u of %d pixels in %d dirty rects",
+			scaledPixels, width * height, _numDirtyRects);
+
 		// Readjust the dirty rect list in case we are doing a full update.
 		// This is necessary if shaking is active.
 		if (_forceRedraw) {
@@ -1526,11 +1534,6 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool re
 	if (_forceRedraw)
 		return;
 
-	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceRedraw = true;
-		return;
-	}
-
 	int height, width;
 
 	if (!_overlayVisible && !realCoordinates) {
@@ -1576,19 +1579,24 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool re
 		makeRectStretchable(x, y, w, h, _videoMode.filtering);
 #endif
 
-	if (w == width && h == height) {
+	if (w == width && h == height && !realCoordinates) {
 		_forceRedraw = true;
 		return;
 	}
 
-	if (w > 0 && h > 0) {
-		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+	if (w <= 0 || h <= 0)
+		return;
 
-		r->x = x;
-		r->y = y;
-		r->w = w;
-		r->h = h;
-	}
+	SDL_Rect rect;
+	rect.x = x;
+	rect.y = y;
+	rect.w = w;
+	rect.h = h;
+
+	// Once the rects merge into one covering the whole screen, it is the
+	// only rect left in the list. This must not set _forceRedraw, since the
+	// mouse cursor is added while the screen is being updated.
+	addDirtyRectToList(_dirtyRectList, _numDirtyRects, NUM_DIRTY_RECT, DIRTY_RECT_COST, rect);
 }
 
 int16 SurfaceSdlGraphicsManager::getHeight() const {
@@ -328,7 +328,10 @@ protected:
 
 	enum {
 		NUM_DIRTY_RECT = 100,
-		MAX_SCALING = 3
+		MAX_SCALING = 3,
+		// Cost of handling a dirty rect, in pixels of scaling work. Dirty rects
+		// are merged when scaling the area covering both costs less than that.
+		DIRTY_RECT_COST = 32 * 32
 	};
 
 	// Dirty rect management
@@ -56,11 +56,12 @@ typedef void (*sighandler_t)(int);
 #include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
 #include "backends/mixer/null/null-mixer.h"
-#include "backends/mutex/null/null-mutex.h"
 #include "backends/graphics/null/null-graphics.h"
 #include "gui/debugger.h"
 #endif
 
+#include "backends/mutex/null/null-mutex.h"
+
 /*
  * Include header files needed for the getFilesystemFactory() method.
  */
@@ -117,6 +118,11 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+	#ifdef NULL_DRIVER_USE_FOR_TEST
+		// Tests never call initBackend(), but may still need mutexes
+		_mutexManager = new NullMutexManager();
+	#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
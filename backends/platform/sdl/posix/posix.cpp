@@ -44,6 +44,8 @@
 #include "backends/audiocd/linux/linux-audiocd.h"
 #endif
 
+#include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/textconsole.h"
 
 #include <stdlib.h>
@@ -61,6 +63,17 @@
 #endif
 extern char **environ;
 
+OSystem_POSIX::~OSystem_POSIX() {
+	// Report how much the directory cache saved, to help tuning fs_cache_ttl
+	uint32 statsSaved, listingsSaved;
+	Posix::getFilesystemCacheStats(statsSaved, listingsSaved);
+	if (statsSaved || listingsSaved)
+		debug(1, "Filesystem cache: %u stat() calls and %u directory listings saved", statsSaved, listingsSaved);
+
+	// The cache uses a mutex, so it must go before the mutex manager
+	Posix::setFilesystemCacheTTL(0);
+}
+
 void OSystem_POSIX::init() {
 	// Initialze File System Factory
 	_fsFactory = new POSIXFilesystemFactory();
@@ -80,6 +93,10 @@ void OSystem_POSIX::init() {
 }
 
 void OSystem_POSIX::initBackend() {
+	// Cache directory listings if requested, e.g. for games on network mounts
+	if (ConfMan.hasKey("fs_cache_ttl"))
+		Posix::setFilesystemCacheTTL(ConfMan.getInt("fs_cache_ttl"));
+
 	// Create the savefile manager
 	if (_savefileManager == 0)
 		_savefileManager = new POSIXSaveFileManager();
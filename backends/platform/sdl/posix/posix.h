@@ -27,6 +27,8 @@
 
 class OSystem_POSIX : public OSystem_SDL {
 public:
+	virtual ~OSystem_POSIX();
+
 	virtual bool hasFeature(Feature f) override;
 
 	virtual bool displayLogFile() override;
@@ -45,11 +45,18 @@
 #include "common/zlib.h"
 
 #include <errno.h>	// for removeSavefile()
+#include <stdio.h>	// for rename()
+
+#if defined(POSIX)
+#include "backends/fs/posix/posix-fs.h"
+#endif
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 const char *DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
+const char *const DefaultSaveFileManager::kTempFileSuffix = ".tmp";
+
 DefaultSaveFileManager::DefaultSaveFileManager() {
 }
 
@@ -57,6 +64,11 @@ DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSave
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	// Don't lose the save files which are still being written.
+	processPendingSaves(true);
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -78,6 +90,9 @@ void DefaultSaveFileManager::updateSavefilesList(Common::StringArray &lockedFile
 }
 
 Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &pattern) {
+	// Make sure the save files written in the background are listed.
+	processPendingSaves(true);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -90,6 +105,11 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 
 	Common::StringArray results;
 	for (SaveFileCache::const_iterator file = _saveFileCache.begin(), end = _saveFileCache.end(); file != end; ++file) {
+		// Skip the temporary files left by an interrupted saveAsync(), they
+		// are incomplete.
+		if (file->_key.hasSuffixIgnoreCase(kTempFileSuffix))
+			continue;
+
 		if (!locked.contains(file->_key) && file->_key.matchString(pattern, true)) {
 			results.push_back(file->_key);
 		}
@@ -98,6 +118,9 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	// Make sure no save file is still being written in the background.
+	processPendingSaves(true);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -114,6 +137,9 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	// Make sure no save file is still being written in the background.
+	processPendingSaves(true);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -136,6 +162,9 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	// Make sure no save file is still being written in the background.
+	processPendingSaves(true);
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::String savePathName = getSavePath();
 	assureCached(savePathName);
@@ -180,6 +209,9 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	// Make sure no save file is still being written in the background.
+	processPendingSaves(true);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -217,11 +249,142 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 
 			return false;
 		} else {
+#if defined(POSIX)
+			// Keep the cached directory listing in sync
+			Posix::invalidateFilesystemCache(fileNode.getPath());
+#endif
 			return true;
 		}
 	}
 }
 
+bool DefaultSaveFileManager::saveAsync(const Common::String &filename, byte *data, uint32 size, bool compress, SaveCallback callback, void *refCon) {
+	// Make sure no save file is still being written in the background,
+	// since it might use the same temporary file.
+	processPendingSaves(true);
+
+	// Assure the savefile name cache is up-to-date.
+	const Common::String savePathName = getSavePath();
+	assureCached(savePathName);
+	if (getError().getCode() != Common::kNoError) {
+		free(data);
+		return false;
+	}
+
+	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i) {
+		if (filename == *i) {
+			free(data);
+			return false; //file is locked, no saving available
+		}
+	}
+
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	// Update file's timestamp
+	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
+	timestamps[filename] = INVALID_TIMESTAMP;
+	saveTimestamps(timestamps);
+#endif
+
+	// The data is written to a temporary file first, so that the previous
+	// save file is kept if writing fails or is interrupted.
+	const Common::FSNode savePath(savePathName);
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	const Common::FSNode fileNode = file == _saveFileCache.end() ? savePath.getChild(filename) : file->_value;
+	const Common::FSNode tempNode = savePath.getChild(fileNode.getName() + kTempFileSuffix);
+
+	Common::WriteStream *const sf = tempNode.createWriteStream();
+	if (!sf) {
+		free(data);
+		return false;
+	}
+
+	PendingSave *save = new PendingSave();
+	save->filename = filename;
+	save->path = fileNode.getPath();
+	save->tempPath = tempNode.getPath();
+	save->file = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	save->data = data;
+	save->size = size;
+	save->written = 0;
+	save->callback = callback;
+	save->refCon = refCon;
+	_pendingSaves.push_back(save);
+
+	return true;
+}
+
+void DefaultSaveFileManager::processPendingSaves(bool wait) {
+	while (!_pendingSaves.empty()) {
+		PendingSave *save = _pendingSaves.front();
+
+		// Unless asked to wait, only compress and write one chunk per call,
+		// so that the game keeps running smoothly.
+		uint32 chunkSize = save->size - save->written;
+		if (!wait)
+			chunkSize = MIN(chunkSize, kPendingSaveChunkSize);
+
+		save->file->write(save->data + save->written, chunkSize);
+		save->written += chunkSize;
+		if (save->written < save->size)
+			return;
+
+		_pendingSaves.pop_front();
+		finishPendingSave(save);
+
+		if (!wait)
+			return;
+	}
+}
+
+bool DefaultSaveFileManager::replaceSavefile(const Common::String &tempPath, const Common::String &path) {
+	// rename() is atomic on POSIX systems, but on some other systems it fails
+	// when the target file exists.
+	if (rename(tempPath.c_str(), path.c_str()) == 0)
+		return true;
+
+	remove(path.c_str());
+	return rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+void DefaultSaveFileManager::finishPendingSave(PendingSave *save) {
+	save->file->finalize();
+	Common::Error result = save->file->err() ? Common::kWritingFailed : Common::kNoError;
+	delete save->file;
+	free(save->data);
+
+	// Only replace the previous save file once the new one is complete
+	if (result.getCode() == Common::kNoError && !replaceSavefile(save->tempPath, save->path))
+		result = Common::kWritingFailed;
+	if (result.getCode() != Common::kNoError)
+		remove(save->tempPath.c_str());
+
+#if defined(POSIX)
+	// Keep the cached directory listing in sync
+	Posix::invalidateFilesystemCache(save->tempPath);
+	Posix::invalidateFilesystemCache(save->path);
+#endif
+
+	if (result.getCode() == Common::kNoError && !_cachedDirectory.empty())
+		_saveFileCache[save->filename] = Common::FSNode(save->path);
+
+	if (save->callback)
+		save->callback(save->filename, result, save->refCon);
+	delete save;
+}
+
+bool DefaultSaveFileManager::getSavefileInfo(const Common::String &filename, uint32 &size, uint32 &modificationTime) {
+	// Make sure no save file is still being written in the background.
+	processPendingSaves(true);
+
+	// The save file cache is not checked here, since this is usually called
+	// right after listSavefiles() for each file it returned.
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return false;
+
+	return file->_value.getFileInfo(size, modificationTime);
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
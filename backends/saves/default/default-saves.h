@@ -28,6 +28,7 @@
 #include "common/str.h"
 #include "common/fs.h"
 #include "common/hash-str.h"
+#include "common/list.h"
 #include <limits.h>
 
 /**
@@ -37,6 +38,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	virtual ~DefaultSaveFileManager();
 
 	virtual void updateSavefilesList(Common::StringArray &lockedFiles);
 	virtual Common::StringArray listSavefiles(const Common::String &pattern);
@@ -44,6 +46,10 @@ public:
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true);
 	virtual bool removeSavefile(const Common::String &filename);
+	virtual bool saveAsync(const Common::String &filename, byte *data, uint32 size, bool compress = true,
+	                       SaveCallback callback = nullptr, void *refCon = nullptr);
+	virtual void processPendingSaves(bool wait = false);
+	virtual bool getSavefileInfo(const Common::String &filename, uint32 &size, uint32 &modificationTime);
 
 #ifdef USE_LIBCURL
 
@@ -70,6 +76,22 @@ protected:
 	 */
 	virtual void checkPath(const Common::FSNode &dir);
 
+	/**
+	 * Replace a save file by the completely written temporary file of a save
+	 * made with saveAsync(). The previous save file should be kept whenever
+	 * this fails. The default implementation uses rename(), and removes the
+	 * target first on systems where renaming over an existing file fails.
+	 *
+	 * Backends overriding this need to call processPendingSaves(true) in
+	 * their destructor, since the destructor of this class can only use the
+	 * default implementation.
+	 *
+	 * @param tempPath  Path of the temporary file.
+	 * @param path      Path of the save file.
+	 * @return true if the save file was replaced.
+	 */
+	virtual bool replaceSavefile(const Common::String &tempPath, const Common::String &path);
+
 	/**
 	 * Assure that the given save path is cached.
 	 *
@@ -99,6 +121,38 @@ private:
 	 * The currently cached directory.
 	 */
 	Common::String _cachedDirectory;
+
+	/**
+	 * A save file handed to saveAsync(). It is written to a temporary file a
+	 * chunk at a time by processPendingSaves(), and replaces the save file
+	 * once it is complete.
+	 */
+	struct PendingSave {
+		Common::String filename;
+		Common::String path;
+		Common::String tempPath;
+		Common::OutSaveFile *file;
+		byte *data;
+		uint32 size;
+		uint32 written;
+		SaveCallback callback;
+		void *refCon;
+	};
+
+	/** Suffix of the temporary files written by saveAsync() */
+	static const char *const kTempFileSuffix;
+
+	/** Amount of data written for each processPendingSaves() call */
+	static const uint32 kPendingSaveChunkSize = 32 * 1024;
+
+	/** Save files waiting to be written, oldest first. */
+	Common::List<PendingSave *> _pendingSaves;
+
+	/**
+	 * Close the completely written temporary file of a pending save, move it
+	 * over the save file and invoke the callback.
+	 */
+	void finishPendingSave(PendingSave *save);
 };
 
 #endif
@@ -56,6 +56,24 @@ int32 OutSaveFile::pos() const {
 	return _wrapped->pos();
 }
 
+bool SaveFileManager::saveAsync(const String &name, byte *data, uint32 size, bool compress, SaveCallback callback, void *refCon) {
+	OutSaveFile *outFile = openForSaving(name, compress);
+	if (!outFile) {
+		free(data);
+		return false;
+	}
+
+	outFile->write(data, size);
+	outFile->finalize();
+	const bool error = outFile->err();
+	delete outFile;
+	free(data);
+
+	if (callback)
+		callback(name, error ? kWritingFailed : kNoError, refCon);
+	return true;
+}
+
 bool SaveFileManager::copySavefile(const String &oldFilename, const String &newFilename, bool compress) {
 	InSaveFile *inFile = 0;
 	OutSaveFile *outFile = 0;
@@ -59,4 +59,14 @@ WindowsSaveFileManager::WindowsSaveFileManager() {
 	}
 }
 
+WindowsSaveFileManager::~WindowsSaveFileManager() {
+	// Write the remaining save files with replaceSavefile() below.
+	processPendingSaves(true);
+}
+
+bool WindowsSaveFileManager::replaceSavefile(const Common::String &tempPath, const Common::String &path) {
+	// Unlike rename(), this replaces an existing file in a single step.
+	return MoveFileEx(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
 #endif
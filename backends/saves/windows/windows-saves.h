@@ -31,6 +31,10 @@
 class WindowsSaveFileManager final : public DefaultSaveFileManager {
 public:
 	WindowsSaveFileManager();
+	~WindowsSaveFileManager() override;
+
+protected:
+	bool replaceSavefile(const Common::String &tempPath, const Common::String &path) override;
 };
 
 #endif
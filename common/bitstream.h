@@ -63,22 +63,21 @@ private:
 	uint32 _size;                           //!< Total bit stream size (in bits).
 	uint32 _pos;                            //!< Current bit stream position (in bits).
 
-	/** Read a data value. */
-	inline uint32 readData() {
+	/** Read a data value from a buffer. */
+	inline static uint32 readData(const byte *data) {
+		if (valueBits ==  8)
+			return *data;
+
 		if (isLE) {
-			if (valueBits ==  8)
-				return _stream->readByte();
 			if (valueBits == 16)
-				return _stream->readUint16LE();
+				return READ_LE_UINT16(data);
 			if (valueBits == 32)
-				return _stream->readUint32LE();
+				return READ_LE_UINT32(data);
 		} else {
-			if (valueBits ==  8)
-				return _stream->readByte();
 			if (valueBits == 16)
-				return _stream->readUint16BE();
+				return READ_BE_UINT16(data);
 			if (valueBits == 32)
-				return _stream->readUint32BE();
+				return READ_BE_UINT32(data);
 		}
 
 		assert(false);
@@ -87,29 +86,43 @@ private:
 
 	/** Fill the container with at least @p min bits. */
 	inline void fillContainer(size_t min) {
-		while (_bitsLeft < min) {
+		if (_bitsLeft >= min)
+			return;
 
-			uint64 data;
-			if (_pos + _bitsLeft + valueBits <= _size) {
-				data = readData();
-			} else {
-				// Peeking data out of bounds is well-defined and returns 0 bits.
-				// This is for convenience when using speed-up techniques reading
-				// more bits than actually available. Call eos() to check if data
-				// was actually read out of bounds. Peeking out of bounds does not
-				// set the eos flag.
-				data = 0;
-			}
+		// Read as many data values as fit into the container with a single
+		// read, rather than calling into the stream for every data value.
+		uint32 count = (64 - _bitsLeft) / valueBits;
 
-			// Move the data value to the right position in the bit container
-			if (MSB2LSB)
-				_bitContainer |= data << (64 - valueBits - _bitsLeft);
-			else
-				_bitContainer |= data << _bitsLeft;
+		const uint32 readPos = _pos + _bitsLeft;
+		const uint32 available = (readPos < _size) ? (_size - readPos) / valueBits : 0;
+		if (count > available)
+			count = available;
 
-			_bitsLeft += valueBits;
+		if (count > 0) {
+			byte buffer[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+			_stream->read(buffer, count * (valueBits / 8));
+
+			for (uint32 i = 0; i < count; i++) {
+				const uint64 data = readData(buffer + i * (valueBits / 8));
+
+				// Move the data value to the right position in the bit container
+				if (MSB2LSB)
+					_bitContainer |= data << (64 - valueBits - _bitsLeft);
+				else
+					_bitContainer |= data << _bitsLeft;
+
+				_bitsLeft += valueBits;
+			}
 		}
-}
+
+		// Peeking data out of bounds is well-defined and returns 0 bits.
+		// This is for convenience when using speed-up techniques reading
+		// more bits than actually available. Call eos() to check if data
+		// was actually read out of bounds. Peeking out of bounds does not
+		// set the eos flag.
+		while (_bitsLeft < min)
+			_bitsLeft += valueBits;
+	}
 
 	/** Get @p n bits from the bit container. */
 	inline static uint32 getNBits(uint64 value, size_t n) {
@@ -342,6 +355,20 @@ public:
 		return true;
 	}
 
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		if (_pos + dataSize > _size) {
+			dataSize = _size - _pos;
+			_eos = true;
+		}
+
+		memcpy(dataPtr, _ptr, dataSize);
+
+		_pos += dataSize;
+		_ptr += dataSize;
+
+		return dataSize;
+	}
+
 	byte readByte() {
 		if (_pos >= _size) {
 			_eos = true;
@@ -382,7 +409,7 @@ public:
 			}
 		}
 
-		uint16 val = READ_LE_UINT16(_ptr);
+		uint16 val = READ_BE_UINT16(_ptr);
 
 		_pos += 2;
 		_ptr += 2;
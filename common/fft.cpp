@@ -31,6 +31,17 @@
 #include "common/util.h"
 #include "common/textconsole.h"
 
+// The vector passes do the same operations as the scalar ones, two complex
+// values at a time, so both give the same results as long as the compiler
+// doesn't fuse the multiplies and adds of the scalar code.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FFT_SSE2_PASS
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FFT_NEON_PASS
+#endif
+
 namespace Common {
 
 FFT::FFT(int bits, int inverse) : _bits(bits), _inverse(inverse) {
@@ -176,10 +187,104 @@ static void name(Complex *z, const float *wre, unsigned int n) { \
 	} while(--n);\
 }
 
+#if defined(FFT_SSE2_PASS)
+
+// Same as PASS, for the values k and k + 1 of each quarter of z, which are
+// kept as {re, im, re, im} in a vector. All the inputs are loaded before
+// storing, as in pass_big.
+static void pass_sse2(Complex *z, const float *wre, unsigned int n) {
+	const int o1 = 2 * n;
+	const int o2 = 4 * n;
+	const int o3 = 6 * n;
+	const float *wim = wre + o1;
+	const __m128 negRe = _mm_castsi128_ps(_mm_set_epi32(0, 0x80000000, 0, 0x80000000));
+	const __m128 negIm = _mm_castsi128_ps(_mm_set_epi32(0x80000000, 0, 0x80000000, 0));
+
+	for (int k = 0; k < o1; k += 2) {
+		// The first twiddle factor is 1, as in TRANSFORM_ZERO
+		const float wre0 = k ? wre[k] : 1.0f;
+		const float wim0 = k ? wim[-k] : 0.0f;
+		const __m128 wr = _mm_set_ps(wre[k + 1], wre[k + 1], wre0, wre0);
+		const __m128 wi = _mm_set_ps(wim[-k - 1], wim[-k - 1], wim0, wim0);
+
+		const __m128 a0 = _mm_loadu_ps(&z[k].re);
+		const __m128 a1 = _mm_loadu_ps(&z[o1 + k].re);
+		const __m128 a2 = _mm_loadu_ps(&z[o2 + k].re);
+		const __m128 a3 = _mm_loadu_ps(&z[o3 + k].re);
+
+		// {t1, t2} and {t5, t6} of TRANSFORM
+		const __m128 t12 = _mm_add_ps(_mm_mul_ps(a2, wr),
+			_mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(a2, a2, _MM_SHUFFLE(2, 3, 0, 1)), wi), negIm));
+		const __m128 t56 = _mm_add_ps(_mm_mul_ps(a3, wr),
+			_mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(a3, a3, _MM_SHUFFLE(2, 3, 0, 1)), wi), negRe));
+
+		// {t5, t6} and {t4, t3} of BUTTERFLIES
+		const __m128 sum = _mm_add_ps(t56, t12);
+		const __m128 diff = _mm_sub_ps(t56, t12);
+		const __m128 rot = _mm_xor_ps(_mm_shuffle_ps(diff, diff, _MM_SHUFFLE(2, 3, 0, 1)), negRe);
+
+		_mm_storeu_ps(&z[k].re, _mm_add_ps(a0, sum));
+		_mm_storeu_ps(&z[o2 + k].re, _mm_sub_ps(a0, sum));
+		_mm_storeu_ps(&z[o1 + k].re, _mm_add_ps(a1, rot));
+		_mm_storeu_ps(&z[o3 + k].re, _mm_sub_ps(a1, rot));
+	}
+}
+
+#elif defined(FFT_NEON_PASS)
+
+// Same as pass_sse2, for NEON
+static void pass_neon(Complex *z, const float *wre, unsigned int n) {
+	const int o1 = 2 * n;
+	const int o2 = 4 * n;
+	const int o3 = 6 * n;
+	const float *wim = wre + o1;
+	static const float signRe[4] = { -1.0f, 1.0f, -1.0f, 1.0f };
+	static const float signIm[4] = { 1.0f, -1.0f, 1.0f, -1.0f };
+	const float32x4_t negRe = vld1q_f32(signRe);
+	const float32x4_t negIm = vld1q_f32(signIm);
+
+	for (int k = 0; k < o1; k += 2) {
+		// The first twiddle factor is 1, as in TRANSFORM_ZERO
+		const float wre0 = k ? wre[k] : 1.0f;
+		const float wim0 = k ? wim[-k] : 0.0f;
+		const float wrs[4] = { wre0, wre0, wre[k + 1], wre[k + 1] };
+		const float wis[4] = { wim0, wim0, wim[-k - 1], wim[-k - 1] };
+		const float32x4_t wr = vld1q_f32(wrs);
+		const float32x4_t wi = vld1q_f32(wis);
+
+		const float32x4_t a0 = vld1q_f32(&z[k].re);
+		const float32x4_t a1 = vld1q_f32(&z[o1 + k].re);
+		const float32x4_t a2 = vld1q_f32(&z[o2 + k].re);
+		const float32x4_t a3 = vld1q_f32(&z[o3 + k].re);
+
+		// {t1, t2} and {t5, t6} of TRANSFORM
+		const float32x4_t t12 = vaddq_f32(vmulq_f32(a2, wr), vmulq_f32(vmulq_f32(vrev64q_f32(a2), wi), negIm));
+		const float32x4_t t56 = vaddq_f32(vmulq_f32(a3, wr), vmulq_f32(vmulq_f32(vrev64q_f32(a3), wi), negRe));
+
+		// {t5, t6} and {t4, t3} of BUTTERFLIES
+		const float32x4_t sum = vaddq_f32(t56, t12);
+		const float32x4_t diff = vsubq_f32(t56, t12);
+		const float32x4_t rot = vmulq_f32(vrev64q_f32(diff), negRe);
+
+		vst1q_f32(&z[k].re, vaddq_f32(a0, sum));
+		vst1q_f32(&z[o2 + k].re, vsubq_f32(a0, sum));
+		vst1q_f32(&z[o1 + k].re, vaddq_f32(a1, rot));
+		vst1q_f32(&z[o3 + k].re, vsubq_f32(a1, rot));
+	}
+}
+
+#else
+
 PASS(pass)
+
+#endif
+
 #undef BUTTERFLIES
 #define BUTTERFLIES BUTTERFLIES_BIG
+
+#if !defined(FFT_SSE2_PASS) && !defined(FFT_NEON_PASS)
 PASS(pass_big)
+#endif
 
 void FFT::fft4(Complex *z) {
 	float t1, t2, t3, t4, t5, t6, t7, t8;
@@ -245,10 +350,16 @@ void FFT::fft(int n, int logn, Complex *z) {
 		fft((n / 4), logn - 2, z + (n / 4) * 2);
 		fft((n / 4), logn - 2, z + (n / 4) * 3);
 		assert(_cosTables[logn - 4]);
+#if defined(FFT_SSE2_PASS)
+		pass_sse2(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#elif defined(FFT_NEON_PASS)
+		pass_neon(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#else
 		if (n > 1024)
 			pass_big(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
 		else
 			pass(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#endif
 	}
 }
 
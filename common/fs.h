@@ -222,6 +222,17 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Get the size and the time of the last modification of the file referred
+	 * by this node. This is not supported by all backends.
+	 *
+	 * @param size              Set to the size of the file, in bytes.
+	 * @param modificationTime  Set to the time of the last modification, in seconds.
+	 *
+	 * @return True if successful, false otherwise.
+	 */
+	bool getFileInfo(uint32 &size, uint32 &modificationTime) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
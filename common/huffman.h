@@ -73,29 +73,28 @@ public:
 	uint32 getSymbol(BITSTREAM &bits) const;
 
 private:
-	struct Symbol {
-		uint32 code;
-		uint32 symbol;
+	/**
+	 * Entry of a lookup table.
+	 *
+	 * The first table is indexed by the next _tableBits bits of the stream.
+	 * Codes longer than that continue in sub-tables, indexed by the bits
+	 * following the ones used for the table pointing to them.
+	 */
+	struct TableEntry {
+		uint32 value;   ///< The symbol, or the offset of the sub-table.
+		uint8  length;  ///< Number of code bits used in this table, 0 for a sub-table or an invalid code.
+		uint8  subBits; ///< Number of index bits of the sub-table, 0 if this is no sub-table.
 
-		Symbol(uint32 c, uint32 s) : code(c), symbol(s) {}
+		TableEntry() : value(0), length(0), subBits(0) {}
 	};
 
-	typedef List<Symbol> CodeList;
-	typedef Array<CodeList> CodeLists;
-
-	/** Lists of codes and their symbols, sorted by code length. */
-	CodeLists _codes;
+	static const uint8 _tableBits = 8;
 
-	/** Prefix lookup table used to speed up the decoding of short codes. */
-	struct PrefixEntry {
-		uint32 symbol;
-		uint8  length;
-
-		PrefixEntry() : length(0xFF) {}
-	};
+	/** All lookup tables, the first one starting at offset 0. */
+	Array<TableEntry> _table;
 
-	static const uint8 _prefixTableBits = 8;
-	PrefixEntry _prefixTable[1 << _prefixTableBits];
+	void buildTable(uint32 offset, uint8 tableBits, uint8 usedBits, const Array<uint32> &codeIndices,
+	                const uint32 *codes, const uint8 *lengths, const uint32 *symbols);
 };
 
 template <class BITSTREAM>
@@ -111,58 +110,96 @@ Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *cod
 
 	assert(maxLength <= 32);
 
-	// Codes that do not fit in the prefix table are stored in the _codes array.
-	_codes.resize(MAX(maxLength - _prefixTableBits, 0));
-
-	for (uint i = 0; i < codeCount; i++) {
-		uint8 length = lengths[i];
-
-		// The symbol. If none was specified, assume it is identical to the code index.
-		uint32 symbol = symbols ? symbols[i] : i;
-
-		if (length <= _prefixTableBits) {
-			// Short codes go in the prefix lookup table. Set all the entries in the table
-			// with an index starting with the code to the symbol value.
-			uint32 startIndex;
-			if (BITSTREAM::isMSB2LSB()) {
-				startIndex = codes[i] << (_prefixTableBits - length);
-			} else {
-				startIndex = REVERSEBITS(codes[i]) >> (32 - _prefixTableBits);
-			}
-
-			uint32 endIndex = startIndex | ((1 << (_prefixTableBits - length)) - 1);
-
-			for (uint32 j = startIndex; j <= endIndex; j++) {
-				uint32 index = BITSTREAM::isMSB2LSB() ? j : REVERSEBITS(j) >> (32 - _prefixTableBits);
-				_prefixTable[index].symbol = symbol;
-				_prefixTable[index].length = length;
-			}
-		} else {
-			// Put the code and symbol into the correct list for the length.
-			_codes[lengths[i] - 1 - _prefixTableBits].push_back(Symbol(codes[i], symbol));
+	Array<uint32> codeIndices;
+	codeIndices.reserve(codeCount);
+	for (uint32 i = 0; i < codeCount; i++)
+		if (lengths[i] > 0)
+			codeIndices.push_back(i);
+
+	_table.resize(1 << _tableBits);
+	buildTable(0, _tableBits, 0, codeIndices, codes, lengths, symbols);
+}
+
+template <class BITSTREAM>
+void Huffman<BITSTREAM>::buildTable(uint32 offset, uint8 tableBits, uint8 usedBits, const Array<uint32> &codeIndices,
+                                    const uint32 *codes, const uint8 *lengths, const uint32 *symbols) {
+	// Codes which don't end in this table, by their index in this table
+	Array<Array<uint32> > longCodes;
+	longCodes.resize(1 << tableBits);
+
+	for (uint32 i = 0; i < codeIndices.size(); i++) {
+		const uint32 c = codeIndices[i];
+		const uint8 bitsLeft = lengths[c] - usedBits;
+		const uint8 indexBits = MIN(bitsLeft, tableBits);
+
+		// The bits of the code indexing this table, in the order they are read
+		// from the stream. Codes are given as read by BITSTREAM::getBits().
+		uint32 index;
+		if (BITSTREAM::isMSB2LSB())
+			index = (codes[c] >> (bitsLeft - indexBits)) & ((1 << indexBits) - 1);
+		else
+			index = (codes[c] >> usedBits) & ((1 << indexBits) - 1);
+
+		if (bitsLeft > tableBits) {
+			longCodes[index].push_back(c);
+			continue;
+		}
+
+		// The code ends in this table. Set all the entries with an index starting
+		// with the code to the symbol value.
+		const uint32 symbol = symbols ? symbols[c] : c;
+		const uint8 fillBits = tableBits - bitsLeft;
+
+		for (uint32 j = 0; j < (1u << fillBits); j++) {
+			uint32 entryIndex = BITSTREAM::isMSB2LSB() ? ((index << fillBits) | j) : (index | (j << bitsLeft));
+			TableEntry &entry = _table[offset + entryIndex];
+			entry.value  = symbol;
+			entry.length = bitsLeft;
 		}
 	}
+
+	// Give the longer codes a sub-table, large enough to hold the longest of
+	// them, but not larger than the first table.
+	for (uint32 index = 0; index < longCodes.size(); index++) {
+		if (longCodes[index].empty())
+			continue;
+
+		uint8 subBits = 0;
+		for (uint32 i = 0; i < longCodes[index].size(); i++)
+			subBits = MAX<uint8>(subBits, lengths[longCodes[index][i]] - usedBits - tableBits);
+		subBits = MIN(subBits, _tableBits);
+
+		const uint32 subOffset = _table.size();
+		_table.resize(subOffset + (1 << subBits));
+
+		TableEntry &entry = _table[offset + index];
+		entry.value   = subOffset;
+		entry.length  = 0;
+		entry.subBits = subBits;
+
+		buildTable(subOffset, subBits, usedBits + tableBits, longCodes[index], codes, lengths, symbols);
+	}
 }
 
 template <class BITSTREAM>
 uint32 Huffman<BITSTREAM>::getSymbol(BITSTREAM &bits) const {
-	uint32 code = bits.peekBits(_prefixTableBits);
+	uint32 offset = 0;
+	uint8 tableBits = _tableBits;
 
-	uint8 length = _prefixTable[code].length;
+	for (;;) {
+		const TableEntry &entry = _table[offset + bits.peekBits(tableBits)];
 
-	if (length != 0xFF) {
-		bits.skip(length);
-		return _prefixTable[code].symbol;
-	} else {
-		bits.skip(_prefixTableBits);
+		if (entry.length) {
+			bits.skip(entry.length);
+			return entry.value;
+		}
 
-		for (uint32 i = 0; i < _codes.size(); i++) {
-			bits.addBit(code, i + _prefixTableBits);
+		if (!entry.subBits)
+			break;
 
-			for (typename CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-				if (code == cCode->code)
-					return cCode->symbol;
-		}
+		bits.skip(tableBits);
+		offset = entry.value;
+		tableBits = entry.subBits;
 	}
 
 	error("Unknown Huffman code");
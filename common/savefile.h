@@ -190,6 +190,66 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Callback invoked when a save file written with saveAsync() has been
+	 * completely written.
+	 *
+	 * @param name    Name of the save file.
+	 * @param result  kNoError on success, or the error which occurred.
+	 * @param refCon  Value passed to saveAsync().
+	 */
+	typedef void (*SaveCallback)(const String &name, Error result, void *refCon);
+
+	/**
+	 * Write an already serialized save file.
+	 *
+	 * The compression and writing of the data may be spread over later calls
+	 * to processPendingSaves(), so that the caller does not stall while the
+	 * whole file is written. The previous save file is only replaced once the
+	 * new one is complete. The callback is invoked either from saveAsync()
+	 * itself or from a later call into the save file manager, such as
+	 * processPendingSaves().
+	 * Any other access to the save files waits for the write to finish.
+	 *
+	 * The default implementation writes the data immediately.
+	 *
+	 * @param name      Name of the save file.
+	 * @param data      Save file contents, allocated with malloc(). The save
+	 *                  file manager takes ownership of the buffer.
+	 * @param size      Size of the save file contents.
+	 * @param compress  Whether to compress the resulting save file or not.
+	 * @param callback  Callback to invoke once the data has been written, or nullptr.
+	 * @param refCon    Value passed to the callback.
+	 *
+	 * @return False if the save file could not be opened for saving, in
+	 *         which case the callback is not invoked.
+	 */
+	virtual bool saveAsync(const String &name, byte *data, uint32 size, bool compress = true,
+	                       SaveCallback callback = nullptr, void *refCon = nullptr);
+
+	/**
+	 * Continue writing the save files passed to saveAsync(), and invoke the
+	 * callbacks of the ones which are complete.
+	 *
+	 * @param wait  If true, write all pending save files. Otherwise only write
+	 *              a small part of them, so that this can be called every frame.
+	 */
+	virtual void processPendingSaves(bool wait = false) {}
+
+	/**
+	 * Get the size and the modification time of a save file. This allows to
+	 * keep data read from a save file, such as its header, until the file
+	 * changes.
+	 *
+	 * @param name              Name of the save file.
+	 * @param size              Set to the size of the file, in bytes.
+	 * @param modificationTime  Set to the time of the last modification of
+	 *                          the file, in seconds.
+	 * @return False if the information is not available, in which case the
+	 *         file has to be read again every time.
+	 */
+	virtual bool getSavefileInfo(const String &name, uint32 &size, uint32 &modificationTime) { return false; }
+
 	/**
 	 * Open the file with the specified @p name in the given directory for loading.
 	 *
@@ -394,6 +394,9 @@ void apply_config(const ConfigTree &cfg) {
 		int cache_size_kb = INIreadint(cfg, "misc", "cachemax", DEFAULTCACHESIZE_KB);
 		if (cache_size_kb > 0)
 			_GP(spriteset).SetMaxCacheSize((size_t)cache_size_kb * 1024);
+		int compressed_cache_size_kb = INIreadint(cfg, "misc", "compressed_cachemax", DEFAULTCOMPRESSEDCACHESIZE_KB);
+		if (compressed_cache_size_kb >= 0)
+			_GP(spriteset).SetMaxCompressedCacheSize((size_t)compressed_cache_size_kb * 1024);
 
 		_GP(usetup).mouse_auto_lock = INIreadint(cfg, "mouse", "auto_lock") > 0;
 
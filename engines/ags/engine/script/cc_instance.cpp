@@ -223,6 +223,7 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	code_ops            = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -423,79 +424,75 @@ int ccInstance::Run(int32_t curpc) {
 		if (_G(abort_engine))
 			return -1;
 
-		/*
-		if (!codeInst->ReadOperation(codeOp, pc))
-		{
-		    return -1;
-		}
-		*/
 		/* ReadOperation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+		// Instruction code, instance id and argument fixup types were all
+		// decoded and validated when the script was loaded
+		const ScriptCodeOp &decodedOp = codeInst->code_ops[pc];
+		if (decodedOp.Code < 0) {
+			const int32_t rawCode = (int32_t)(codeInst->code[pc] & INSTANCE_ID_REMOVEMASK);
+			if (rawCode >= CC_NUM_SCCMDS) {
+				cc_error("invalid instruction %d found in code stream", rawCode);
+			} else {
+				cc_error("unexpected end of code data (%d; %d)", pc + sccmd_info[rawCode].ArgCount, codeInst->codesize);
+			}
 			return -1;
 		}
 
-		codeOp.ArgCount = sccmd_info[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
-		}
+		codeOp.Instruction.Code         = decodedOp.Code;
+		codeOp.Instruction.InstanceId   = decodedOp.InstanceId;
+		codeOp.ArgCount                 = decodedOp.ArgCount;
 
-		int pc_at = pc + 1;
-		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
-			if (fixup > 0) {
-				// could be relative pointer or import address
-				/*
-				if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
-				{
-				    return -1;
-				}
-				*/
-				/* FixupArgument */
-				//=====================================================================
-				switch (fixup) {
-				case FIXUP_GLOBALDATA: {
-					ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
-					codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
-				}
-				break;
-				case FIXUP_FUNCTION:
-					// originally commented -- CHECKME: could this be used in very old versions of AGS?
-					//      code[fixup] += (long)&code[0];
-					// This is a program counter value, presumably will be used as SCMD_CALL argument
-					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+		const intptr_t *codeArgs = &codeInst->code[pc + 1];
+		if (!decodedOp.HasFixups) {
+			// Fast path: all the arguments are numeric literals (int32 or float)
+			for (int i = 0; i < codeOp.ArgCount; ++i)
+				codeOp.Args[i].SetInt32((int32_t)codeArgs[i]);
+		} else {
+			for (int i = 0; i < codeOp.ArgCount; ++i) {
+				char fixup = decodedOp.ArgFixups[i];
+				if (fixup > 0) {
+					// could be relative pointer or import address
+					/* FixupArgument */
+					//=====================================================================
+					switch (fixup) {
+					case FIXUP_GLOBALDATA: {
+						ScriptVariable *gl_var = (ScriptVariable *)codeArgs[i];
+						codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
+					}
 					break;
-				case FIXUP_STRING:
-					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
+					case FIXUP_FUNCTION:
+						// originally commented -- CHECKME: could this be used in very old versions of AGS?
+						//      code[fixup] += (long)&code[0];
+						// This is a program counter value, presumably will be used as SCMD_CALL argument
+						codeOp.Args[i].SetInt32((int32_t)codeArgs[i]);
+						break;
+					case FIXUP_STRING:
+						codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeArgs[i]);
+						break;
+					case FIXUP_IMPORT: {
+						const ScriptImport *import = _GP(simp).getByIndex((int32_t)codeArgs[i]);
+						if (import) {
+							codeOp.Args[i] = import->Value;
+						} else {
+							cc_error("cannot resolve import, key = %ld", codeArgs[i]);
+							return -1;
+						}
+					}
 					break;
-				case FIXUP_IMPORT: {
-					const ScriptImport *import = _GP(simp).getByIndex((int32_t)codeInst->code[pc_at]);
-					if (import) {
-						codeOp.Args[i] = import->Value;
-					} else {
-						cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
+					case FIXUP_STACK:
+						codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeArgs[i]);
+						break;
+					default:
+						cc_error("internal fixup type error: %d", fixup);
 						return -1;
 					}
+					/* End FixupArgument */
+					//=====================================================================
+				} else {
+					// should be a numeric literal (int32 or float)
+					codeOp.Args[i].SetInt32((int32_t)codeArgs[i]);
 				}
-				break;
-				case FIXUP_STACK:
-					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
-					break;
-				default:
-					cc_error("internal fixup type error: %d", fixup);
-					return -1;
-				}
-				/* End FixupArgument */
-				//=====================================================================
-			} else {
-				// should be a numeric literal (int32 or float)
-				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 			}
 		}
 		/* End ReadOperation */
@@ -1408,6 +1405,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		code_ops = joined->code_ops;
 	} else {
 		if (!ResolveScriptImports(scri)) {
 			return false;
@@ -1418,6 +1416,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 		if (!CreateRuntimeCodeFixups(scri)) {
 			return false;
 		}
+		CreateDecodedCode();
 	}
 
 	exports = new RuntimeScriptValue[scri->numexports];
@@ -1493,9 +1492,11 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete [] resolved_imports;
 		delete [] code_fixups;
+		delete [] code_ops;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	code_ops = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(PScript scri) {
@@ -1666,6 +1667,32 @@ bool ccInstance::CreateRuntimeCodeFixups(PScript scri) {
 	return true;
 }
 
+void ccInstance::CreateDecodedCode() {
+	// NOTE: we decode every code position, not only the ones reached by
+	// walking the code linearly, so that a jump to any address behaves
+	// exactly as if the instruction was decoded at run time
+	code_ops = new ScriptCodeOp[codesize];
+	for (int32_t at_pc = 0; at_pc < codesize; ++at_pc) {
+		ScriptCodeOp &op = code_ops[at_pc];
+		const int32_t instr = (int32_t)code[at_pc];
+		const int32_t instr_code = instr & INSTANCE_ID_REMOVEMASK;
+		if (instr_code < 0 || instr_code >= CC_NUM_SCCMDS)
+			continue;
+		const int arg_count = sccmd_info[instr_code].ArgCount;
+		if (at_pc + arg_count >= codesize)
+			continue;
+
+		op.Code = instr_code;
+		op.InstanceId = (instr >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+		op.ArgCount = arg_count;
+		for (int i = 0; i < arg_count; ++i) {
+			op.ArgFixups[i] = code_fixups[at_pc + 1 + i];
+			if (op.ArgFixups[i] > 0)
+				op.HasFixups = 1;
+		}
+	}
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int32_t at_pc)
 {
@@ -78,6 +78,24 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// Instruction header decoded once at load time; there is one per code
+// position, so that any valid program counter indexes it directly
+struct ScriptCodeOp {
+	ScriptCodeOp() {
+		Code = -1;
+		InstanceId = 0;
+		ArgCount = 0;
+		HasFixups = 0;
+		memset(ArgFixups, 0, sizeof(ArgFixups));
+	}
+
+	int32_t Code;       // pure instruction code, or -1 if no valid instruction may start here
+	uint8_t InstanceId;
+	uint8_t ArgCount;
+	uint8_t HasFixups;  // whether any of the arguments needs a runtime fixup
+	char    ArgFixups[MAX_SCMD_ARGS];
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -149,6 +167,8 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// pre-decoded instruction headers, one per code position
+	ScriptCodeOp *code_ops;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -191,6 +211,9 @@ protected:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(PScript scri);
+	// Decodes instruction headers for every code position; must be run
+	// after the runtime fixups were applied
+	void    CreateDecodedCode();
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
 
 	// Runtime fixups
@@ -28,6 +28,16 @@
 #include "common/textconsole.h"
 #include "graphics/screen.h"
 
+// The SSE2 row kernels blend in double precision like the scalar code, and give
+// the same results as long as the scalar code also uses SSE2 arithmetic. This is
+// not the case with x87 math, which is the default for 32-bit x86 builds and has
+// a higher intermediate precision, nor when the compiler may fuse multiplies and
+// adds in the scalar code.
+#if defined(__SSE2__) && defined(__SSE2_MATH__) && !defined(__FMA__)
+#include <emmintrin.h>
+#define AGS_SSE2_BLENDING
+#endif
+
 namespace AGS3 {
 
 BITMAP::BITMAP(Graphics::ManagedSurface *owner) : _owner(owner),
@@ -108,6 +118,12 @@ void BITMAP::floodfill(int x, int y, int color) {
 const int SCALE_THRESHOLD = 0x100;
 #define VGA_COLOR_TRANS(x) ((x) * 255 / 63)
 
+static inline bool isARGB8888(const Graphics::PixelFormat &format) {
+	return format.bytesPerPixel == 4 && format.aBits() == 8 && format.rBits() == 8 &&
+		format.gBits() == 8 && format.bBits() == 8 && format.aShift == 24 &&
+		format.rShift == 16 && format.gShift == 8 && format.bShift == 0;
+}
+
 void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 		int dstX, int dstY, bool horizFlip, bool vertFlip,
 		bool skipTrans, int srcAlpha, int tintRed, int tintGreen,
@@ -138,6 +154,9 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	const int xDir = horizFlip ? -1 : 1;
 	bool useTint = (tintRed >= 0 && tintGreen >= 0 && tintBlue >= 0);
 	bool sameFormat = (src.format == format);
+	// Blending 32-bit sprites onto a 32-bit surface is the common case in
+	// hi-res games, so it goes through the specialized row kernels
+	bool useRowKernel = sameFormat && srcAlpha != -1 && !useTint && isARGB8888(format);
 
 	byte rSrc, gSrc, bSrc, aSrc;
 	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
@@ -170,6 +189,13 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 			vertFlip ? srcRect.bottom - 1 - yCtr :
 			srcRect.top + yCtr);
 
+		if (useRowKernel) {
+			blendRow((uint32 *)destP, (const uint32 *)srcP, MAX(0, -xStart),
+				MIN<int>(dstRect.width(), destArea.w - xStart), xStart,
+				xDir * SCALE_THRESHOLD, skipTrans, srcAlpha);
+			continue;
+		}
+
 		// Loop through the pixels of the row
 		for (int destX = xStart, xCtr = 0, xCtrBpp = 0; xCtr < dstRect.width(); ++destX, ++xCtr, xCtrBpp += src.format.bytesPerPixel) {
 			if (destX < 0 || destX >= destArea.w)
@@ -265,6 +291,7 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	const int scaleX = SCALE_THRESHOLD * srcRect.width() / dstRect.width();
 	const int scaleY = SCALE_THRESHOLD * srcRect.height() / dstRect.height();
 	bool sameFormat = (src.format == format);
+	bool useRowKernel = sameFormat && srcAlpha != -1 && isARGB8888(format);
 
 	byte rSrc, gSrc, bSrc, aSrc;
 	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
@@ -296,6 +323,13 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 		const byte *srcP = (const byte *)src.getBasePtr(
 			srcRect.left, srcRect.top + scaleYCtr / SCALE_THRESHOLD);
 
+		if (useRowKernel) {
+			blendRow((uint32 *)destP, (const uint32 *)srcP, MAX(0, -xStart),
+				MIN<int>(dstRect.width(), destArea.w - xStart), xStart,
+				scaleX, skipTrans, srcAlpha);
+			continue;
+		}
+
 		// Loop through the pixels of the row
 		for (int destX = xStart, xCtr = 0, scaleXCtr = 0; xCtr < dstRect.width();
 				++destX, ++xCtr, scaleXCtr += scaleX) {
@@ -389,6 +423,195 @@ void BITMAP::blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &a
 	}
 }
 
+#ifdef AGS_SSE2_BLENDING
+
+// Blends one color channel of four pixels, given in the low byte of each 32-bit
+// lane, as rgbBlend does
+static inline __m128i blendChannelSSE2(__m128i src, __m128i dest, __m128d alphaLo, __m128d alphaHi,
+		__m128d invAlphaLo, __m128d invAlphaHi) {
+	const __m128i srcHi = _mm_shuffle_epi32(src, _MM_SHUFFLE(1, 0, 3, 2));
+	const __m128i destHi = _mm_shuffle_epi32(dest, _MM_SHUFFLE(1, 0, 3, 2));
+	const __m128d lo = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(src), alphaLo),
+		_mm_mul_pd(_mm_cvtepi32_pd(dest), invAlphaLo));
+	const __m128d hi = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(srcHi), alphaHi),
+		_mm_mul_pd(_mm_cvtepi32_pd(destHi), invAlphaHi));
+	return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+}
+
+// Equivalent of rgbBlend for four pixels. alpha holds a value from 0 to 255
+// in each 32-bit lane. The alpha byte of the result is 0.
+static inline __m128i rgbBlendSSE2(__m128i src, __m128i dest, __m128i alpha) {
+	const __m128d scale = _mm_set1_pd(255.0), one = _mm_set1_pd(1.0);
+	const __m128d alphaLo = _mm_div_pd(_mm_cvtepi32_pd(alpha), scale);
+	const __m128d alphaHi = _mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(alpha, _MM_SHUFFLE(1, 0, 3, 2))), scale);
+	const __m128d invAlphaLo = _mm_sub_pd(one, alphaLo), invAlphaHi = _mm_sub_pd(one, alphaHi);
+	const __m128i mask = _mm_set1_epi32(0xff);
+
+	const __m128i r = blendChannelSSE2(_mm_and_si128(_mm_srli_epi32(src, 16), mask),
+		_mm_and_si128(_mm_srli_epi32(dest, 16), mask), alphaLo, alphaHi, invAlphaLo, invAlphaHi);
+	const __m128i g = blendChannelSSE2(_mm_and_si128(_mm_srli_epi32(src, 8), mask),
+		_mm_and_si128(_mm_srli_epi32(dest, 8), mask), alphaLo, alphaHi, invAlphaLo, invAlphaHi);
+	const __m128i b = blendChannelSSE2(_mm_and_si128(src, mask), _mm_and_si128(dest, mask),
+		alphaLo, alphaHi, invAlphaLo, invAlphaHi);
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 16), _mm_slli_epi32(g, 8)), b);
+}
+
+// Blends four pixels at a time for the blender modes which don't need
+// divisions by the destination alpha. The source must not be flipped or
+// stretched. Returns the position at which the scalar code has to continue.
+template<int BlenderMode>
+static int blendRowSSE2(uint32 *destP, const uint32 *srcP, int xStart, int xEnd, bool skipTrans, uint32 alpha) {
+	if (BlenderMode != kOpaqueBlenderMode && BlenderMode != kAdditiveBlenderMode &&
+			BlenderMode != kRgbToRgbBlender && BlenderMode != kAlphaPreservedBlenderMode &&
+			BlenderMode != kSourceAlphaBlender && BlenderMode != kArgbToRgbBlender)
+		return xStart;
+
+	const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+	const __m128i transColor = _mm_set1_epi32(0x00ff00ff);
+	const __m128i constAlpha = _mm_set1_epi32(alpha & 0xff);
+	const __m128i alphaFactor = _mm_set1_epi32((alpha & 0xff) + 1);
+
+	int x = xStart;
+	for (; x + 4 <= xEnd; x += 4) {
+		const __m128i src = _mm_loadu_si128((const __m128i *)(srcP + x));
+		const __m128i dest = _mm_loadu_si128((const __m128i *)(destP + x));
+		const __m128i srcAlpha = _mm_srli_epi32(src, 24);
+		__m128i result;
+
+		switch (BlenderMode) {
+		case kOpaqueBlenderMode:
+			result = _mm_or_si128(src, alphaMask);
+			break;
+		case kAdditiveBlenderMode:
+			result = _mm_or_si128(_mm_andnot_si128(alphaMask, src),
+				_mm_and_si128(_mm_adds_epu8(src, dest), alphaMask));
+			break;
+		case kRgbToRgbBlender:
+			result = rgbBlendSSE2(src, dest, constAlpha);
+			break;
+		case kAlphaPreservedBlenderMode:
+			result = _mm_or_si128(rgbBlendSSE2(src, dest, constAlpha), _mm_and_si128(dest, alphaMask));
+			break;
+		case kSourceAlphaBlender:
+			result = rgbBlendSSE2(src, dest, srcAlpha);
+			break;
+		default: // kArgbToRgbBlender
+			// The products fit in 16 bits, so a 16-bit multiply is enough
+			result = rgbBlendSSE2(src, dest, (alpha == 0) ? srcAlpha :
+				_mm_srli_epi32(_mm_mullo_epi16(srcAlpha, alphaFactor), 8));
+			break;
+		}
+
+		if (skipTrans) {
+			// Keep the destination where the source has the transparent color
+			const __m128i trans = _mm_cmpeq_epi32(_mm_andnot_si128(alphaMask, src), transColor);
+			result = _mm_or_si128(_mm_and_si128(trans, dest), _mm_andnot_si128(trans, result));
+		}
+
+		_mm_storeu_si128((__m128i *)(destP + x), result);
+	}
+
+	return x;
+}
+
+#endif
+
+template<int BlenderMode>
+void BITMAP::blendRowARGB(uint32 *destP, const uint32 *srcP, int xStart, int xEnd, int destOffset,
+		int srcScale, bool skipTrans, uint32 alpha) const {
+	// Transparent color is bright pink with any alpha (see draw)
+	const uint32 transColor = 0x00ff00ff, alphaMask = 0x00ffffff;
+
+#ifdef AGS_SSE2_BLENDING
+	if (srcScale == SCALE_THRESHOLD)
+		xStart = blendRowSSE2<BlenderMode>(destP + destOffset, srcP, xStart, xEnd, skipTrans, alpha);
+#endif
+
+	for (int x = xStart; x < xEnd; ++x) {
+		uint32 srcCol = srcP[x * srcScale / SCALE_THRESHOLD];
+		if (skipTrans && ((srcCol & alphaMask) == transColor))
+			continue;
+
+		uint32 &destCol = destP[x + destOffset];
+		uint8 aSrc = srcCol >> 24, rSrc = srcCol >> 16, gSrc = srcCol >> 8, bSrc = srcCol;
+		uint8 aDest = destCol >> 24, rDest = destCol >> 16, gDest = destCol >> 8, bDest = destCol;
+
+		// BlenderMode is a constant, so only one branch remains after compilation
+		switch (BlenderMode) {
+		case kSourceAlphaBlender:
+			blendSourceAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kArgbToArgbBlender:
+			blendArgbToArgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kArgbToRgbBlender:
+			blendArgbToRgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kRgbToArgbBlender:
+			blendRgbToArgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kRgbToRgbBlender:
+			blendRgbToRgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kAlphaPreservedBlenderMode:
+			blendPreserveAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kOpaqueBlenderMode:
+			blendOpaque(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kAdditiveBlenderMode:
+			blendAdditiveAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kTintBlenderMode:
+			blendTintSprite(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha, false);
+			break;
+		case kTintLightBlenderMode:
+			blendTintSprite(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha, true);
+			break;
+		default:
+			break;
+		}
+
+		destCol = ((uint32)aDest << 24) | ((uint32)rDest << 16) | ((uint32)gDest << 8) | bDest;
+	}
+}
+
+void BITMAP::blendRow(uint32 *destP, const uint32 *srcP, int xStart, int xEnd, int destOffset,
+		int srcScale, bool skipTrans, uint32 alpha) const {
+	switch (_G(_blender_mode)) {
+	case kSourceAlphaBlender:
+		blendRowARGB<kSourceAlphaBlender>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kArgbToArgbBlender:
+		blendRowARGB<kArgbToArgbBlender>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kArgbToRgbBlender:
+		blendRowARGB<kArgbToRgbBlender>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kRgbToArgbBlender:
+		blendRowARGB<kRgbToArgbBlender>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kRgbToRgbBlender:
+		blendRowARGB<kRgbToRgbBlender>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kAlphaPreservedBlenderMode:
+		blendRowARGB<kAlphaPreservedBlenderMode>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kOpaqueBlenderMode:
+		blendRowARGB<kOpaqueBlenderMode>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kAdditiveBlenderMode:
+		blendRowARGB<kAdditiveBlenderMode>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kTintBlenderMode:
+		blendRowARGB<kTintBlenderMode>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	case kTintLightBlenderMode:
+		blendRowARGB<kTintLightBlenderMode>(destP, srcP, xStart, xEnd, destOffset, srcScale, skipTrans, alpha);
+		break;
+	}
+}
+
 void BITMAP::blendTintSprite(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha, bool light) const {
 	// Used from draw_lit_sprite after set_blender_mode(kTintBlenderMode or kTintLightBlenderMode)
 	// Original blender function: _myblender_color32 and _myblender_color32_light
@@ -124,6 +124,16 @@ private:
 
 	void blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const;
 
+	// Row kernels used when blending between two 32-bit ARGB8888 bitmaps.
+	// The pixels in [xStart, xEnd) are blended, reading the source pixel
+	// at x * srcScale / SCALE_THRESHOLD and writing the dest pixel at
+	// x + destOffset. The blender mode is resolved once per row.
+	void blendRow(uint32 *destP, const uint32 *srcP, int xStart, int xEnd, int destOffset,
+		int srcScale, bool skipTrans, uint32 alpha) const;
+	template<int BlenderMode>
+	void blendRowARGB(uint32 *destP, const uint32 *srcP, int xStart, int xEnd, int destOffset,
+		int srcScale, bool skipTrans, uint32 alpha) const;
+
 
 	inline void rgbBlend(uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
 		// Original logic has uint32 src and dst colors as RGB888
@@ -80,6 +80,7 @@ MODULE_OBJS = \
 	shared/util/inifile.o \
 	shared/util/ini_util.o \
 	shared/util/lzw.o \
+	shared/util/memorystream.o \
 	shared/util/misc.o \
 	shared/util/mutifilelib.o \
 	shared/util/path.o \
@@ -325,6 +326,8 @@ MODULE_OBJS += \
 	tests/test_inifile.o \
 	tests/test_math.o \
 	tests/test_memory.o \
+	tests/test_script.o \
+	tests/test_sprcache.o \
 	tests/test_sprintf.o \
 	tests/test_string.o \
 	tests/test_version.o
@@ -40,6 +40,7 @@
 #include "ags/shared/gfx/bitmap.h"
 #include "ags/shared/util/compress.h"
 #include "ags/shared/util/file.h"
+#include "ags/shared/util/memorystream.h"
 #include "ags/shared/util/stream.h"
 #include "common/system.h"
 
@@ -103,6 +104,14 @@ size_t SpriteCache::GetMaxCacheSize() const {
 	return _maxCacheSize;
 }
 
+size_t SpriteCache::GetCompressedCacheSize() const {
+	return _compressedStore.GetSize();
+}
+
+size_t SpriteCache::GetMaxCompressedCacheSize() const {
+	return _compressedStore.GetMaxSize();
+}
+
 sprkey_t SpriteCache::GetSpriteSlotCount() const {
 	return _spriteData.size();
 }
@@ -119,6 +128,10 @@ void SpriteCache::SetMaxCacheSize(size_t size) {
 	_maxCacheSize = size;
 }
 
+void SpriteCache::SetMaxCompressedCacheSize(size_t size) {
+	_compressedStore.SetMaxSize(size);
+}
+
 void SpriteCache::Init() {
 	_cacheSize = 0;
 	_lockedSize = 0;
@@ -126,6 +139,8 @@ void SpriteCache::Init() {
 	_liststart = -1;
 	_listend = -1;
 	_lastLoad = -2;
+	_compressedStore.FreeAll();
+	_compressedStore.SetMaxSize((size_t)DEFAULTCOMPRESSEDCACHESIZE_KB * 1024);
 }
 
 void SpriteCache::Reset() {
@@ -154,6 +169,7 @@ void SpriteCache::SetSprite(sprkey_t index, Bitmap *sprite) {
 		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Error, "SetSprite: attempt to assign nullptr to index %d", index);
 		return;
 	}
+	_compressedStore.Free(index);
 	_spriteData[index].Image = sprite;
 	_spriteData[index].Flags = SPRCACHEFLAG_LOCKED; // NOT from asset file
 	_spriteData[index].Offset = 0;
@@ -178,6 +194,7 @@ void SpriteCache::SubstituteBitmap(sprkey_t index, Shared::Bitmap *sprite) {
 		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Error, "SubstituteBitmap: attempt to set for non-existing sprite %d", index);
 		return;
 	}
+	_compressedStore.Free(index);
 	_spriteData[index].Image = sprite;
 #ifdef DEBUG_SPRITECACHE
 	Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Debug, "SubstituteBitmap: %d", index);
@@ -187,6 +204,7 @@ void SpriteCache::SubstituteBitmap(sprkey_t index, Shared::Bitmap *sprite) {
 void SpriteCache::RemoveSprite(sprkey_t index, bool freeMemory) {
 	if (freeMemory)
 		delete _spriteData[index].Image;
+	_compressedStore.Free(index);
 	InitNullSpriteParams(index);
 #ifdef DEBUG_SPRITECACHE
 	Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Debug, "RemoveSprite: %d", index);
@@ -211,6 +229,7 @@ sprkey_t SpriteCache::GetFreeIndex() {
 	for (size_t i = MIN_SPRITE_INDEX; i < _spriteData.size(); ++i) {
 		// slot empty
 		if (!DoesSpriteExist(i)) {
+			_compressedStore.Free(i);
 			_sprInfos[i] = SpriteInfo();
 			_spriteData[i] = SpriteData();
 			return i;
@@ -302,6 +321,7 @@ void SpriteCache::DisposeOldest() {
 		}
 		_cacheSize -= _spriteData[sprnum].Size;
 
+		_compressedStore.Store(sprnum, _spriteData[sprnum].Image);
 		delete _spriteData[sprnum].Image;
 		_spriteData[sprnum].Image = nullptr;
 	}
@@ -349,6 +369,7 @@ void SpriteCache::DisposeAll() {
 		_mrubacklink[i] = 0;
 	}
 	_cacheSize = _lockedSize;
+	_compressedStore.FreeAll();
 }
 
 void SpriteCache::Precache(sprkey_t index) {
@@ -383,10 +404,17 @@ void SpriteCache::SeekToSprite(sprkey_t index) {
 		_stream->Seek(_spriteData[index].Offset, kSeekBegin);
 }
 
-size_t SpriteCache::LoadSprite(sprkey_t index) {
+void SpriteCache::FreeUpSpace() {
 	int hh = 0;
 
-	while (_cacheSize > _maxCacheSize) {
+	while (_cacheSize + _compressedStore.GetSize() > _maxCacheSize) {
+		// Disposed images move to the compressed store, which takes less space;
+		// when there are no more images to dispose, drop the compressed ones
+		if (_liststart < 0) {
+			if (!_compressedStore.FreeOldest())
+				break;
+			continue;
+		}
 		DisposeOldest();
 		hh++;
 		if (hh > 1000) {
@@ -394,10 +422,31 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 			DisposeAll();
 		}
 	}
+}
+
+size_t SpriteCache::LoadSprite(sprkey_t index) {
+	int hh = 0;
+
+	FreeUpSpace();
 
 	if (index < 0 || (size_t)index >= _spriteData.size())
 		quit("sprite cache array index out of bounds");
 
+	// Sprite was evicted recently and its compressed copy is still in memory
+	if (_compressedStore.Has(index)) {
+		Bitmap *image = _compressedStore.Restore(index);
+		if (image) {
+			// The image was already prepared by the engine before it was stored,
+			// so it does not need to be initialized again
+			_spriteData[index].Image = image;
+			_cacheSize += _spriteData[index].Size;
+#ifdef DEBUG_SPRITECACHE
+			Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Debug, "Restored %d, size now %u KB", index, _cacheSize / 1024);
+#endif
+			return _spriteData[index].Size;
+		}
+	}
+
 	sprkey_t load_index = GetDataIndex(index);
 	SeekToSprite(load_index);
 
@@ -472,6 +521,7 @@ void SpriteCache::RemapSpriteToSprite0(sprkey_t index) {
 	_sprInfos[index].Width = _sprInfos[0].Width;
 	_sprInfos[index].Height = _sprInfos[0].Height;
 	_spriteData[index].Image = nullptr;
+	_compressedStore.Free(index);
 	_spriteData[index].Offset = _spriteData[0].Offset;
 	_spriteData[index].Size = _spriteData[0].Size;
 	_spriteData[index].Flags |= SPRCACHEFLAG_REMAPPED;
@@ -482,6 +532,104 @@ void SpriteCache::RemapSpriteToSprite0(sprkey_t index) {
 
 const char *spriteFileSig = " Sprite File ";
 
+CompressedSpriteStore::CompressedSpriteStore()
+	: _maxSize((size_t)DEFAULTCOMPRESSEDCACHESIZE_KB * 1024)
+	, _size(0) {
+}
+
+size_t CompressedSpriteStore::GetSize() const {
+	return _size;
+}
+
+size_t CompressedSpriteStore::GetMaxSize() const {
+	return _maxSize;
+}
+
+void CompressedSpriteStore::SetMaxSize(size_t size) {
+	_maxSize = size;
+	while (_size > _maxSize && FreeOldest()) {
+	}
+}
+
+bool CompressedSpriteStore::Has(sprkey_t index) const {
+	return index >= 0 && (size_t)index < _images.size() && !_images[index].empty();
+}
+
+bool CompressedSpriteStore::Store(sprkey_t index, Bitmap *image) {
+	Free(index);
+	if (_maxSize == 0 || !image || index < 0)
+		return false;
+	const int bpp = image->GetBPP();
+	if (bpp != 1 && bpp != 2 && bpp != 4)
+		return false;
+
+	std::vector<uint8_t> data;
+	{
+		VectorStream out(data);
+		out.WriteInt16(image->GetColorDepth());
+		out.WriteInt16(image->GetWidth());
+		out.WriteInt16(image->GetHeight());
+		SpriteCache::CompressSprite(image, &out);
+	}
+	// Keeping a copy which is not smaller than the image would not save anything
+	const size_t rawSize = (size_t)image->GetWidth() * image->GetHeight() * bpp;
+	if (data.size() >= rawSize || data.size() > _maxSize)
+		return false;
+
+	// Make room by dropping the sprites that were stored first
+	while (_size + data.size() > _maxSize)
+		FreeOldest();
+	if ((size_t)index >= _images.size())
+		_images.resize(index + 1);
+	_images[index].swap(data);
+	_size += _images[index].size();
+	_order.push_back(index);
+
+#ifdef DEBUG_SPRITECACHE
+	Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Debug, "Compressed %d, %u bytes, store size now %u KB", index, _images[index].size(), _size / 1024);
+#endif
+	return true;
+}
+
+Bitmap *CompressedSpriteStore::Restore(sprkey_t index) {
+	if (!Has(index))
+		return nullptr;
+
+	Bitmap *image;
+	{
+		VectorStream in(_images[index]);
+		int coldep = in.ReadInt16();
+		int wdd = in.ReadInt16();
+		int htt = in.ReadInt16();
+		image = BitmapHelper::CreateBitmap(wdd, htt, coldep);
+		if (image)
+			SpriteCache::UnCompressSprite(image, &in);
+	}
+	Free(index);
+	return image;
+}
+
+void CompressedSpriteStore::Free(sprkey_t index) {
+	if (!Has(index))
+		return;
+	_size -= _images[index].size();
+	// Release the memory, clear() alone would keep it reserved
+	std::vector<uint8_t>().swap(_images[index]);
+	_order.remove(index);
+}
+
+bool CompressedSpriteStore::FreeOldest() {
+	if (_order.empty())
+		return false;
+	Free(_order.front());
+	return true;
+}
+
+void CompressedSpriteStore::FreeAll() {
+	while (FreeOldest()) {
+	}
+}
+
 void SpriteCache::CompressSprite(Bitmap *sprite, Stream *out) {
 	const int depth = sprite->GetBPP();
 	if (depth == 1) {
@@ -45,6 +45,7 @@
 #ifndef AGS_SHARED_AC_SPRITECACHE_H
 #define AGS_SHARED_AC_SPRITECACHE_H
 
+#include "ags/lib/std/list.h"
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/vector.h"
 #include "ags/shared/core/platform.h"
@@ -78,6 +79,14 @@ struct SpriteInfo;
 #define DEFAULTCACHESIZE_KB (128 * 1024)
 #endif
 
+// Max share of the sprite cache which may be taken by compressed copies of
+// evicted sprites, in bytes. These copies count against the cache size limit.
+#if AGS_PLATFORM_OS_ANDROID || AGS_PLATFORM_OS_IOS
+#define DEFAULTCOMPRESSEDCACHESIZE_KB (8 * 1024)
+#else
+#define DEFAULTCOMPRESSEDCACHESIZE_KB (32 * 1024)
+#endif
+
 // TODO: research old version differences
 enum SpriteFileVersion {
 	kSprfVersion_Uncompressed = 4,
@@ -110,6 +119,44 @@ struct SpriteFileIndex {
 };
 
 
+// Keeps compressed copies of sprite images which were disposed from the
+// sprite cache, so that they may be restored without reading the sprite file.
+// When running over its size limit the store drops the images that were
+// stored first.
+class CompressedSpriteStore {
+public:
+	CompressedSpriteStore();
+
+	// Returns current size of the stored images, in bytes
+	size_t      GetSize() const;
+	// Returns maximal size limit of the store, in bytes
+	size_t      GetMaxSize() const;
+	// Sets max size of the store in bytes, dropping images if needed; 0 disables the store
+	void        SetMaxSize(size_t size);
+	// Tells if there's a compressed image stored for the given sprite
+	bool        Has(sprkey_t index) const;
+	// Stores a compressed copy of the image; returns false if it was not
+	// stored, which happens when compression doesn't make it any smaller
+	bool        Store(sprkey_t index, Shared::Bitmap *image);
+	// Creates an image from the stored copy and removes it from the store;
+	// returns nullptr if there is no copy or the image could not be created
+	Shared::Bitmap *Restore(sprkey_t index);
+	// Deletes the compressed image of the given sprite, if there's one
+	void        Free(sprkey_t index);
+	// Deletes the image that was stored first; returns false if the store is empty
+	bool        FreeOldest();
+	// Deletes all the compressed images
+	void        FreeAll();
+
+private:
+	size_t _maxSize; // store size limit
+	size_t _size;    // size in bytes of currently stored images
+	// Compressed images, indexed by sprite
+	std::vector<std::vector<uint8_t> > _images;
+	// Sprites that have compressed images, in the order they were stored
+	std::list<sprkey_t> _order;
+};
+
 class SpriteCache {
 public:
 	static const sprkey_t MIN_SPRITE_INDEX = 1; // 0 is reserved for "empty sprite"
@@ -137,6 +184,11 @@ public:
 	size_t      GetLockedSize() const;
 	// Returns maximal size limit of the cache, in bytes
 	size_t      GetMaxCacheSize() const;
+	// Returns current size of the compressed sprite store, in bytes;
+	// this is included in the cache size limit
+	size_t      GetCompressedCacheSize() const;
+	// Returns maximal size limit of the compressed sprite store, in bytes
+	size_t      GetMaxCompressedCacheSize() const;
 	// Returns number of sprite slots in the bank (this includes both actual sprites and free slots)
 	sprkey_t    GetSpriteSlotCount() const;
 	// Finds the topmost occupied slot index. Warning: may be slow.
@@ -161,6 +213,8 @@ public:
 	void        SubstituteBitmap(sprkey_t index, Shared::Bitmap *);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Sets max size of the compressed sprite store in bytes; 0 disables it
+	void        SetMaxCompressedCacheSize(size_t size);
 
 	// Loads sprite reference information and inits sprite stream
 	HAGSError   InitFile(const char *filename, const char *sprindex_filename);
@@ -176,6 +230,11 @@ public:
 	// Saves sprite index table in a separate file
 	int         SaveSpriteIndex(const char *filename, const SpriteFileIndex &index);
 
+	// Writes compressed sprite to the stream
+	static void CompressSprite(Shared::Bitmap *sprite, Shared::Stream *out);
+	// Uncompresses sprite from stream into the given bitmap
+	static void UnCompressSprite(Shared::Bitmap *sprite, Shared::Stream *in);
+
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Shared::Bitmap *operator[](sprkey_t index);
 
@@ -190,6 +249,8 @@ private:
 	void        SeekToSprite(sprkey_t index);
 	// Delete the oldest image in cache
 	void        DisposeOldest();
+	// Frees cache space until the images and their compressed copies fit in the limit
+	void        FreeUpSpace();
 
 	// Information required for the sprite streaming
 	// TODO: split into sprite cache and sprite stream data
@@ -235,15 +296,13 @@ private:
 	int _liststart;
 	int _listend;
 
+	// Compressed copies of the images disposed from the cache
+	CompressedSpriteStore _compressedStore;
+
 	// Loads sprite index file
 	bool        LoadSpriteIndexFile(const char *filename, int expectedFileID, soff_t spr_initial_offs, sprkey_t topmost);
 	// Rebuilds sprite index from the main sprite file
 	HAGSError   RebuildSpriteIndex(AGS::Shared::Stream *in, sprkey_t topmost, SpriteFileVersion vers);
-	// Writes compressed sprite to the stream
-	void        CompressSprite(Shared::Bitmap *sprite, Shared::Stream *out);
-	// Uncompresses sprite from stream into the given bitmap
-	void        UnCompressSprite(Shared::Bitmap *sprite, Shared::Stream *in);
-
 	// Initialize the empty sprite slot
 	void        InitNullSpriteParams(sprkey_t index);
 };
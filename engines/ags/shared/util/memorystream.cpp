@@ -0,0 +1,137 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "ags/shared/util/memorystream.h"
+
+namespace AGS3 {
+namespace AGS {
+namespace Shared {
+
+VectorStream::VectorStream(std::vector<uint8_t> &buf, DataEndianess stream_endianess)
+	: DataStream(stream_endianess)
+	, _buf(&buf)
+	, _pos(0) {
+}
+
+VectorStream::~VectorStream() {
+	VectorStream::Close();
+}
+
+void VectorStream::Close() {
+	_buf = nullptr;
+	_pos = 0;
+}
+
+bool VectorStream::Flush() {
+	return true;
+}
+
+bool VectorStream::IsValid() const {
+	return _buf != nullptr;
+}
+
+bool VectorStream::EOS() const {
+	return !_buf || _pos >= _buf->size();
+}
+
+soff_t VectorStream::GetLength() const {
+	return _buf ? _buf->size() : 0;
+}
+
+soff_t VectorStream::GetPosition() const {
+	return _buf ? _pos : -1;
+}
+
+bool VectorStream::CanRead() const {
+	return _buf != nullptr;
+}
+
+bool VectorStream::CanWrite() const {
+	return _buf != nullptr;
+}
+
+bool VectorStream::CanSeek() const {
+	return _buf != nullptr;
+}
+
+size_t VectorStream::Read(void *buffer, size_t size) {
+	if (EOS())
+		return 0;
+	size = MIN(size, _buf->size() - _pos);
+	memcpy(buffer, &(*_buf)[_pos], size);
+	_pos += size;
+	return size;
+}
+
+int32_t VectorStream::ReadByte() {
+	if (EOS())
+		return -1;
+	return (*_buf)[_pos++];
+}
+
+size_t VectorStream::Write(const void *buffer, size_t size) {
+	if (!_buf || size == 0)
+		return 0;
+	if (_pos + size > _buf->size())
+		_buf->resize(_pos + size);
+	memcpy(&(*_buf)[_pos], buffer, size);
+	_pos += size;
+	return size;
+}
+
+int32_t VectorStream::WriteByte(uint8_t b) {
+	if (!_buf)
+		return -1;
+	if (_pos == _buf->size())
+		_buf->push_back(b);
+	else
+		(*_buf)[_pos] = b;
+	_pos++;
+	return b;
+}
+
+bool VectorStream::Seek(soff_t offset, StreamSeek origin) {
+	if (!_buf)
+		return false;
+	soff_t want_pos;
+	switch (origin) {
+	case kSeekBegin:
+		want_pos = offset;
+		break;
+	case kSeekCurrent:
+		want_pos = _pos + offset;
+		break;
+	case kSeekEnd:
+		want_pos = _buf->size() + offset;
+		break;
+	default:
+		return false;
+	}
+	if (want_pos < 0 || (size_t)want_pos > _buf->size())
+		return false;
+	_pos = want_pos;
+	return true;
+}
+
+} // namespace Shared
+} // namespace AGS
+} // namespace AGS3
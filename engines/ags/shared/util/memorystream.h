@@ -0,0 +1,77 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+//=============================================================================
+//
+// VectorStream reads from and writes to a byte vector kept in memory.
+// The vector is not owned by the stream and grows as the data is written
+// past its end.
+//
+//=============================================================================
+
+#ifndef AGS_SHARED_UTIL_MEMORYSTREAM_H
+#define AGS_SHARED_UTIL_MEMORYSTREAM_H
+
+#include "ags/lib/std/vector.h"
+#include "ags/shared/util/datastream.h"
+
+namespace AGS3 {
+namespace AGS {
+namespace Shared {
+
+class VectorStream : public DataStream {
+public:
+	VectorStream(std::vector<uint8_t> &buf, DataEndianess stream_endianess = kLittleEndian);
+	~VectorStream() override;
+
+	void    Close() override;
+	bool    Flush() override;
+
+	// Is stream valid (underlying data initialized properly)
+	bool    IsValid() const override;
+	// Is end of stream
+	bool    EOS() const override;
+	// Total length of stream (if known)
+	soff_t  GetLength() const override;
+	// Current position (if known)
+	soff_t  GetPosition() const override;
+	bool    CanRead() const override;
+	bool    CanWrite() const override;
+	bool    CanSeek() const override;
+
+	size_t  Read(void *buffer, size_t size) override;
+	int32_t ReadByte() override;
+	size_t  Write(const void *buffer, size_t size) override;
+	int32_t WriteByte(uint8_t b) override;
+
+	bool    Seek(soff_t offset, StreamSeek origin) override;
+
+private:
+	std::vector<uint8_t> *_buf;
+	size_t _pos;
+};
+
+} // namespace Shared
+} // namespace AGS
+} // namespace AGS3
+
+#endif
@@ -34,8 +34,10 @@ void Test_DoAllTests() {
 	Test_Version();
 	Test_File();
 	Test_IniFile();
+	Test_Script();
 
 	Test_Gfx();
+	Test_SpriteCache();
 }
 
 } // namespace AGS3
@@ -35,6 +35,10 @@ extern void Test_IniFile();
 
 // Graphics tests
 extern void Test_Gfx();
+extern void Test_SpriteCache();
+
+// Script interpreter tests
+extern void Test_Script();
 
 // Memory / bit-byte operations
 extern void Test_Memory();
@@ -21,13 +21,125 @@
  */
 
 #include "common/scummsys.h"
+#include "common/system.h"
 #include "ags/shared/core/platform.h"
 #include "ags/shared/gfx/gfx_def.h"
-#include "ags/shared/debugging/assert.h"
+#include "ags/shared/debugging/out.h"
+#include "ags/lib/allegro/color.h"
+#include "ags/lib/allegro/surface.h"
 
 namespace AGS3 {
 
 namespace GfxDef = AGS::Shared::GfxDef;
+using namespace AGS::Shared;
+
+static const BlenderMode blenderModes[] = {
+	kSourceAlphaBlender, kArgbToArgbBlender, kArgbToRgbBlender, kRgbToArgbBlender,
+	kRgbToRgbBlender, kAlphaPreservedBlenderMode, kOpaqueBlenderMode,
+	kAdditiveBlenderMode, kTintBlenderMode, kTintLightBlenderMode
+};
+
+// Fills the bitmap with pseudo-random colors, one pixel out of eight
+// being the transparent color
+static void FillBitmap(BITMAP *bmp, uint32 seed) {
+	for (int y = 0; y < bmp->h; ++y) {
+		uint32 *row = (uint32 *)bmp->getBasePtr(0, y);
+		for (int x = 0; x < bmp->w; ++x) {
+			seed = seed * 1103515245 + 12345;
+			uint8 a = seed >> 24, r = seed >> 16, g = seed >> 8, b = seed;
+			if ((seed & 0x700) == 0) {
+				r = 255;
+				g = 0;
+				b = 255;
+			}
+			row[x] = bmp->format.ARGBToColor(a, r, g, b);
+		}
+	}
+}
+
+static bool CompareBitmaps(const BITMAP *bmp1, const BITMAP *bmp2) {
+	for (int y = 0; y < bmp1->h; ++y) {
+		for (int x = 0; x < bmp1->w; ++x) {
+			uint8 a1, r1, g1, b1, a2, r2, g2, b2;
+			bmp1->format.colorToARGB(bmp1->getpixel(x, y), a1, r1, g1, b1);
+			bmp2->format.colorToARGB(bmp2->getpixel(x, y), a2, r2, g2, b2);
+			if (a1 != a2 || r1 != r2 || g1 != g2 || b1 != b2)
+				return false;
+		}
+	}
+	return true;
+}
+
+// Checks that the row kernels used for 32-bit ARGB bitmaps give exactly the
+// same result as the generic per-pixel code, which is used for any other
+// pixel format
+static void Test_BlenderModes() {
+	const Graphics::PixelFormat argbFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	const Graphics::PixelFormat abgrFormat(4, 8, 8, 8, 8, 0, 8, 16, 24);
+	const int alphas[] = { 0, 1, 100, 127, 128, 200, 254, 255 };
+	const int size = 48;
+
+	BITMAP *srcArgb = new Surface(size, size, argbFormat);
+	BITMAP *srcAbgr = new Surface(size, size, abgrFormat);
+	BITMAP *destArgb = new Surface(size, size, argbFormat);
+	BITMAP *destAbgr = new Surface(size, size, abgrFormat);
+	FillBitmap(srcArgb, 1);
+	FillBitmap(srcAbgr, 1);
+	const Common::Rect srcRect(0, 0, size, size);
+
+	for (int m = 0; m < ARRAYSIZE(blenderModes); ++m) {
+		for (int i = 0; i < ARRAYSIZE(alphas); ++i) {
+			set_blender_mode(blenderModes[m], 0, 0, 0, alphas[i]);
+
+			FillBitmap(destArgb, 2);
+			FillBitmap(destAbgr, 2);
+			destArgb->draw(srcArgb, srcRect, 0, 0, false, false, true, alphas[i]);
+			destAbgr->draw(srcAbgr, srcRect, 0, 0, false, false, true, alphas[i]);
+			assert(CompareBitmaps(destArgb, destAbgr));
+
+			// Flipped and clipped
+			destArgb->draw(srcArgb, srcRect, -5, 7, true, false, false, alphas[i]);
+			destAbgr->draw(srcAbgr, srcRect, -5, 7, true, false, false, alphas[i]);
+			assert(CompareBitmaps(destArgb, destAbgr));
+
+			// Stretched and clipped
+			const Common::Rect stretchRect(3, -4, size * 3 / 2, size - 10);
+			destArgb->stretchDraw(srcArgb, srcRect, stretchRect, true, alphas[i]);
+			destAbgr->stretchDraw(srcAbgr, srcRect, stretchRect, true, alphas[i]);
+			assert(CompareBitmaps(destArgb, destAbgr));
+		}
+	}
+
+	delete srcArgb;
+	delete srcAbgr;
+	delete destArgb;
+	delete destAbgr;
+}
+
+// Times translucent sprite drawing for every blender mode
+static void Test_BlenderModesSpeed() {
+	const Graphics::PixelFormat argbFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	const int iterations = 100;
+
+	BITMAP *sprite = new Surface(256, 256, argbFormat);
+	BITMAP *screen = new Surface(640, 480, argbFormat);
+	FillBitmap(sprite, 3);
+	FillBitmap(screen, 4);
+	const Common::Rect srcRect(0, 0, sprite->w, sprite->h);
+
+	for (int m = 0; m < ARRAYSIZE(blenderModes); ++m) {
+		set_blender_mode(blenderModes[m], 0, 0, 0, 128);
+		uint32 startTime = g_system->getMillis();
+		for (int i = 0; i < iterations; ++i)
+			screen->draw(sprite, srcRect, i, i, false, false, true, 128);
+		uint32 elapsed = g_system->getMillis() - startTime;
+		Debug::Printf(kDbgMsg_Info, "Blender mode %d: %d sprite draws in %u ms",
+			blenderModes[m], iterations, elapsed);
+	}
+
+	delete sprite;
+	delete screen;
+}
 
 void Test_Gfx() {
 	// Test that every transparency which is a multiple of 10 is converted
@@ -42,6 +154,9 @@ void Test_Gfx() {
 		trans100_back[i] = GfxDef::LegacyTrans255ToTrans100(trans255[i]);
 		assert(trans100[i] == trans100_back[i]);
 	}
+
+	Test_BlenderModes();
+	Test_BlenderModesSpeed();
 }
 
 } // namespace AGS3
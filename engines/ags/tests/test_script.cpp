@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/scummsys.h"
+#include "common/system.h"
+#include "ags/shared/core/platform.h"
+#include "ags/shared/debugging/out.h"
+#include "ags/shared/script/cc_script.h"
+#include "ags/shared/script/script_common.h"
+#include "ags/shared/util/string_compat.h"
+#include "ags/engine/script/cc_instance.h"
+
+namespace AGS3 {
+
+using namespace AGS::Shared;
+
+// Builds a script with a single exported function "ScriptBench", which runs
+// a tight integer loop for the given number of iterations and returns
+// 3 * iterations in AX
+static PScript CreateLoopScript(int32_t iterations) {
+	const int32_t code[] = {
+		SCMD_LITTOREG, SREG_AX, iterations, //  0: ax = iterations
+		SCMD_LITTOREG, SREG_BX, 0,          //  3: bx = 0
+		SCMD_ADD,      SREG_BX, 3,          //  6: bx += 3
+		SCMD_SUB,      SREG_AX, 1,          //  9: ax -= 1
+		SCMD_JNZ,      -8,                  // 12: if (ax != 0) goto 6
+		SCMD_REGTOREG, SREG_BX, SREG_AX,    // 14: ax = bx
+		SCMD_RET                            // 17: return ax
+	};
+
+	PScript scri(new ccScript());
+	scri->codesize = ARRAYSIZE(code);
+	scri->code = (int32_t *)malloc(sizeof(code));
+	memcpy(scri->code, code, sizeof(code));
+	// A script is required to have at least one import entry
+	scri->numimports = 1;
+	scri->imports = (char **)malloc(sizeof(char *));
+	scri->imports[0] = nullptr;
+	scri->numexports = 1;
+	scri->exports = (char **)malloc(sizeof(char *));
+	scri->exports[0] = ags_strdup("ScriptBench");
+	scri->export_addr = (int32_t *)malloc(sizeof(int32_t));
+	scri->export_addr[0] = (EXPORT_FUNCTION << 24) | 0;
+	return scri;
+}
+
+void Test_Script() {
+	const int32_t iterations = 1000000;
+	PScript scri = CreateLoopScript(iterations);
+	ccInstance *inst = ccInstance::CreateFromScript(scri);
+	assert(inst);
+
+	uint32 startTime = g_system->getMillis();
+	int result = inst->CallScriptFunction("ScriptBench", 0, nullptr);
+	uint32 elapsed = g_system->getMillis() - startTime;
+	assert(result == 0);
+	assert(inst->returnValue == 3 * iterations);
+
+	// Each loop iteration executes three instructions
+	Debug::Printf(kDbgMsg_Info, "Script benchmark: %d instructions in %u ms",
+		iterations * 3 + 4, elapsed);
+	delete inst;
+}
+
+} // namespace AGS3
@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "common/scummsys.h"
+#include "ags/shared/core/platform.h"
+#include "ags/shared/ac/spritecache.h"
+#include "ags/shared/gfx/bitmap.h"
+
+namespace AGS3 {
+
+using namespace AGS::Shared;
+
+// Creates a bitmap which either has rows of a single color, which compress
+// well, or is filled with noise, which does not compress at all
+static Bitmap *CreateTestBitmap(int width, int height, int depth, bool noise) {
+	Bitmap *bmp = BitmapHelper::CreateBitmap(width, height, depth);
+	uint32 seed = depth;
+	for (int y = 0; y < height; ++y) {
+		uint8 *row = bmp->GetScanLineForWriting(y);
+		for (int x = 0; x < width * bmp->GetBPP(); ++x) {
+			seed = seed * 1103515245 + 12345;
+			row[x] = noise ? (uint8)(seed >> 16) : (uint8)(y * 7);
+		}
+	}
+	return bmp;
+}
+
+static bool CompareBitmaps(Bitmap *bmp1, Bitmap *bmp2) {
+	if (bmp1->GetWidth() != bmp2->GetWidth() || bmp1->GetHeight() != bmp2->GetHeight() ||
+		bmp1->GetColorDepth() != bmp2->GetColorDepth())
+		return false;
+	for (int y = 0; y < bmp1->GetHeight(); ++y) {
+		if (memcmp(bmp1->GetScanLine(y), bmp2->GetScanLine(y), bmp1->GetLineLength()) != 0)
+			return false;
+	}
+	return true;
+}
+
+static void Test_CompressedStoreRoundTrip() {
+	static const int depths[] = { 8, 16, 32 };
+	for (int i = 0; i < 3; ++i) {
+		CompressedSpriteStore store;
+		Bitmap *bmp = CreateTestBitmap(40, 30, depths[i], false);
+		assert(store.Store(5, bmp));
+		assert(store.Has(5));
+		assert(!store.Has(4));
+		assert(store.GetSize() > 0);
+		assert(store.GetSize() < (size_t)bmp->GetLineLength() * bmp->GetHeight());
+
+		Bitmap *restored = store.Restore(5);
+		assert(restored);
+		assert(CompareBitmaps(bmp, restored));
+		// Restoring takes the image out of the store
+		assert(!store.Has(5));
+		assert(store.GetSize() == 0);
+		assert(store.Restore(5) == nullptr);
+		delete restored;
+		delete bmp;
+	}
+
+	// Images which do not get smaller are not kept
+	CompressedSpriteStore store;
+	Bitmap *bmp = CreateTestBitmap(40, 30, 32, true);
+	assert(!store.Store(1, bmp));
+	assert(!store.Has(1));
+	assert(store.GetSize() == 0);
+	delete bmp;
+}
+
+static void Test_CompressedStoreEviction() {
+	CompressedSpriteStore store;
+	Bitmap *bmp = CreateTestBitmap(40, 30, 16, false);
+	assert(store.Store(1, bmp));
+	const size_t size = store.GetSize();
+
+	// Storing over the limit drops the images that were stored first
+	store.SetMaxSize(size * 2);
+	assert(store.Store(2, bmp));
+	assert(store.Store(3, bmp));
+	assert(!store.Has(1));
+	assert(store.Has(2) && store.Has(3));
+	assert(store.GetSize() == size * 2);
+
+	// Storing the same sprite again replaces its copy
+	assert(store.Store(2, bmp));
+	assert(store.Has(2) && store.Has(3));
+	assert(store.GetSize() == size * 2);
+
+	// Now sprite 3 is the oldest one
+	store.SetMaxSize(size);
+	assert(store.Has(2) && !store.Has(3));
+	assert(store.GetSize() == size);
+
+	assert(store.FreeOldest());
+	assert(!store.FreeOldest());
+	assert(store.GetSize() == 0);
+
+	// Zero limit disables the store
+	store.SetMaxSize(0);
+	assert(!store.Store(1, bmp));
+	assert(store.GetSize() == 0);
+	delete bmp;
+}
+
+void Test_SpriteCache() {
+	Test_CompressedStoreRoundTrip();
+	Test_CompressedStoreEviction();
+}
+
+} // namespace AGS3
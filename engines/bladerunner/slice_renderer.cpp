@@ -363,6 +363,17 @@ void SliceLineIterator::advance() {
 	_sliceMatrix._m[1][2] += _field_38 * 64.0f;
 }
 
+template<typename PixelType>
+static inline void drawSpan(uint16 *zbufferLine, void *linePtr, int x, int endX, int maxX, uint16 z, uint32 color) {
+	PixelType *line = (PixelType *)linePtr;
+	for (; x != endX; ++x) {
+		if (z < zbufferLine[x]) {
+			zbufferLine[x] = z;
+			line[MIN(x, maxX)] = (PixelType)color;
+		}
+	}
+}
+
 static void setupLookupTable(int t[256], int inc) {
 	int v = 0;
 	for (int i = 0; i != 256; ++i) {
@@ -545,6 +556,9 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
+	void *linePtr = surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	int maxX = surface.w - 1;
+
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
@@ -573,26 +587,40 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
-					uint32 outColor = palette.value[p[2]];
-					if (advanced) {
-						Color256 aescColor = { 0, 0, 0 };
-						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
-
-						Color256 color = palette.color[p[2]];
-						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
-						color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
-						color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
-
-						int bladeToScummVmConstant = 256 / 32;
-						outColor = _pixelFormat.RGBToColor(CLIP(color.r * bladeToScummVmConstant, 0, 255), CLIP(color.g * bladeToScummVmConstant, 0, 255), CLIP(color.b * bladeToScummVmConstant, 0, 255));
+					// skip the hidden start of the span, and with it the color
+					// calculation when the whole span is hidden
+					int x = previousVertexX;
+					while (x != vertexX && vertexZ >= zbufferLine[x]) {
+						++x;
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
-						if (vertexZ < zbufferLine[x]) {
-							zbufferLine[x] = (uint16)vertexZ;
+					if (x != vertexX) {
+						uint32 outColor = palette.value[p[2]];
+						if (advanced) {
+							Color256 aescColor = { 0, 0, 0 };
+							_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
+
+							Color256 color = palette.color[p[2]];
+							color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
+							color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
+							color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
+
+							int bladeToScummVmConstant = 256 / 32;
+							outColor = _pixelFormat.RGBToColor(CLIP(color.r * bladeToScummVmConstant, 0, 255), CLIP(color.g * bladeToScummVmConstant, 0, 255), CLIP(color.b * bladeToScummVmConstant, 0, 255));
+						}
 
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
-							drawPixel(surface, dstPtr, outColor);
+						switch (surface.format.bytesPerPixel) {
+						case 1:
+							drawSpan<uint8>(zbufferLine, linePtr, x, vertexX, maxX, vertexZ, outColor);
+							break;
+						case 2:
+							drawSpan<uint16>(zbufferLine, linePtr, x, vertexX, maxX, vertexZ, outColor);
+							break;
+						case 4:
+							drawSpan<uint32>(zbufferLine, linePtr, x, vertexX, maxX, vertexZ, outColor);
+							break;
+						default:
+							break;
 						}
 					}
 				}
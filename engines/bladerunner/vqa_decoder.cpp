@@ -142,6 +142,7 @@ VQADecoder::VQADecoder() {
 VQADecoder::~VQADecoder() {
 	for (uint i = _codebooks.size(); i != 0; --i) {
 		delete[] _codebooks[i - 1].data;
+		delete[] _codebooks[i - 1].pixels;
 	}
 	delete _audioTrack;
 	delete _videoTrack;
@@ -468,6 +469,7 @@ bool VQADecoder::readCINF(Common::SeekableReadStream *s, uint32 size) {
 		_codebooks[codebookCount - i].frame = s->readUint16LE();
 		_codebooks[codebookCount - i].size  = s->readUint32LE();
 		_codebooks[codebookCount - i].data  = nullptr;
+		_codebooks[codebookCount - i].pixels = nullptr;
 
 		// debug("Codebook %2u: %4d %8d", codebookCount - i, _codebooks[codebookCount - i].frame, _codebooks[codebookCount - i].size);
 
@@ -597,6 +599,7 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 	_maxZBUFChunkSize = vqaDecoder->_maxZBUFChunkSize;
 
 	_codebook = nullptr;
+	_codebookPixels = nullptr;
 	_cbfz     = nullptr;
 
 	_vpointerSize = 0;
@@ -818,37 +821,80 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 	return true;
 }
 
+void VQADecoder::VQAVideoTrack::convertCodebook(CodebookInfo &codebookInfo, const Graphics::PixelFormat &format) {
+	if (codebookInfo.pixels && codebookInfo.pixelsFormat == format) {
+		return;
+	}
+
+	uint32 pixelCount = _maxBlocks * _blockW * _blockH;
+	uint8 bytesPerPixel = format.bytesPerPixel;
+
+	delete[] codebookInfo.pixels;
+	codebookInfo.pixels = new uint8[pixelCount * bytesPerPixel];
+	codebookInfo.pixelsFormat = format;
+
+	const uint8 *src = codebookInfo.data;
+	uint8 *dst = codebookInfo.pixels;
+	uint8 a, r, g, b;
+
+	for (uint32 i = pixelCount; i != 0; --i) {
+		getGameDataColor(READ_LE_UINT16(src), a, r, g, b);
+		src += 2;
+
+		// Ignore the alpha in the output as it is inversed in the input
+		uint32 color = format.RGBToColor(r, g, b);
+		switch (bytesPerPixel) {
+			case 1:
+				*dst = (uint8)color;
+				break;
+			case 2:
+				*(uint16 *)dst = (uint16)color;
+				break;
+			case 4:
+				*(uint32 *)dst = color;
+				break;
+			default:
+				break;
+		}
+		dst += bytesPerPixel;
+	}
+}
+
 void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
+	uint8 bytesPerPixel = surface->format.bytesPerPixel;
+	uint32 lineSize = _blockW * bytesPerPixel;
+
 	const uint8 *const block_src = &_codebook[2 * srcBlock * _blockW * _blockH];
+	const uint8 *const block_pixels = &_codebookPixels[srcBlock * _blockH * lineSize];
 
 	uint16 blocks_per_line = _width / _blockW;
 
 	uint32 dst_x = 0;
 	uint32 dst_y = 0;
-	uint16 vqaColor = 0;
-	uint8 a, r, g, b;
 
 	for (uint i = count; i != 0; --i) {
 		dst_x = (dstBlock + count - i) % blocks_per_line * _blockW + _offsetX;
 		dst_y = (dstBlock + count - i) / blocks_per_line * _blockH + _offsetY;
 
 		const uint8 *src_p = block_src;
-
-		for (uint y = _blockH; y != 0; --y) {
-			for (uint x = _blockW; x != 0; --x) {
-				vqaColor = READ_LE_UINT16(src_p);
-				src_p += 2;
-
-				getGameDataColor(vqaColor, a, r, g, b);
-
-				if (!(alpha && a)) {
-					// clip is too slow and it is not needed
-					// void* dstPtr = surface->getBasePtr(CLIP(dst_x + x, (uint32)0, (uint32)(surface->w - 1)), CLIP(dst_y + y, (uint32)0, (uint32)(surface->h - 1)));
-					void* dstPtr = surface->getBasePtr(dst_x + _blockW - x, dst_y + _blockH - y);
-					// Ignore the alpha in the output as it is inversed in the input
-					drawPixel(*surface, dstPtr, surface->format.RGBToColor(r, g, b));
+		const uint8 *pixels_p = block_pixels;
+
+		for (uint y = 0; y != _blockH; ++y) {
+			// clip is too slow and it is not needed
+			uint8 *dstPtr = (uint8 *)surface->getBasePtr(dst_x, dst_y + y);
+
+			if (!alpha) {
+				memcpy(dstPtr, pixels_p, lineSize);
+			} else {
+				for (uint x = 0; x != _blockW; ++x) {
+					if (!(READ_LE_UINT16(src_p + 2 * x) & 0x8000)) {
+						memcpy(dstPtr + x * bytesPerPixel, pixels_p + x * bytesPerPixel, bytesPerPixel);
+					}
 				}
 			}
+
+			src_p += 2 * _blockW;
+			pixels_p += lineSize;
 		}
 	}
 }
@@ -864,6 +910,9 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	if (!_codebook || !_vpointer)
 		return false;
 
+	convertCodebook(codebookInfo, surface->format);
+	_codebookPixels = codebookInfo.pixels;
+
 	uint8 *src = _vpointer;
 	uint8 *end = _vpointer + _vpointerSize;
 
@@ -133,6 +133,11 @@ public:
 		uint16  frame;
 		uint32  size;
 		uint8  *data;
+
+		// codebook converted to the pixel format of the surface, so frames
+		// using it only need to copy its blocks
+		uint8                 *pixels;
+		Graphics::PixelFormat  pixelsFormat;
 	};
 
 	class VQAVideoTrack;
@@ -216,6 +221,7 @@ public:
 		uint32  _maxZBUFChunkSize;
 
 		uint8   *_codebook;
+		uint8   *_codebookPixels;
 		uint8   *_cbfz;
 		uint32   _zbufChunkSize;
 		uint8   *_zbufChunk;
@@ -232,6 +238,7 @@ public:
 		uint8   *_screenEffectsData;
 		uint32   _screenEffectsDataSize;
 
+		void convertCodebook(CodebookInfo &codebookInfo, const Graphics::PixelFormat &format);
 		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha = false);
 		bool decodeFrame(Graphics::Surface *surface);
 	};
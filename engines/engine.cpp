@@ -181,6 +181,9 @@ Engine::Engine(OSystem *syst)
 }
 
 Engine::~Engine() {
+	// Finish writing any autosave still pending
+	_saveFileMan->processPendingSaves(true);
+
 	_mixer->stopAll();
 
 	delete _debugger;
@@ -525,6 +528,9 @@ void Engine::checkCD() {
 }
 
 void Engine::handleAutoSave() {
+	// Write the next part of any pending autosave
+	_saveFileMan->processPendingSaves();
+
 	const int diff = _system->getMillis() - _lastAutosaveTime;
 
 	if (_autosaveInterval != 0 && diff > (_autosaveInterval * 1000)) {
@@ -762,7 +768,38 @@ bool Engine::canLoadGameStateCurrently() {
 	return false;
 }
 
+void Engine::autosaveWritten(const Common::String &name, Common::Error result, void *refCon) {
+	if (result.getCode() != Common::kNoError)
+		g_system->displayMessageOnOSD(_("Error occurred making autosave"));
+}
+
 Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool isAutosave) {
+	if (isAutosave) {
+		// Serialize the game into memory, and leave the compression and the
+		// writing of the file to the save file manager, which spreads them
+		// over the next frames so that the game does not stall.
+		Common::MemoryWriteStreamDynamic *buffer = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::OutSaveFile *saveFile = new Common::OutSaveFile(buffer);
+
+		Common::Error result = saveGameStream(saveFile, isAutosave);
+		if (result.getCode() == Common::kNoError)
+			getMetaEngine()->appendExtendedSave(saveFile, getTotalPlayTime() / 1000, desc, isAutosave);
+
+		byte *data = buffer->getData();
+		const uint32 size = buffer->size();
+		delete saveFile;
+
+		if (result.getCode() != Common::kNoError) {
+			free(data);
+			return result;
+		}
+
+		if (!_saveFileMan->saveAsync(getSaveStateName(slot), data, size, true, &autosaveWritten, nullptr))
+			return Common::kWritingFailed;
+
+		return Common::kNoError;
+	}
+
 	Common::OutSaveFile *saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
 
 	if (!saveFile)
@@ -427,6 +427,9 @@ public:
 	/**
 	 * Save a game state.
 	 *
+	 * Autosaves are serialized into memory, and then compressed and written
+	 * a part at a time over the next frames by the save file manager.
+	 *
 	 * @param slot        The slot into which the save state should be stored.
 	 * @param desc        Description for the save state, entered by the user.
 	 * @param isAutosave  Expected to be true if an autosave is being created.
@@ -601,6 +604,11 @@ public:
 	 */
 	void saveAutosaveIfEnabled();
 
+	/**
+	 * Report errors of autosaves written in the background.
+	 */
+	static void autosaveWritten(const Common::String &name, Common::Error result, void *refCon);
+
 	/**
 	 * Indicate whether an autosave can currently be done.
 	 */
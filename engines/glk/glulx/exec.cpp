@@ -25,11 +25,80 @@
 namespace Glk {
 namespace Glulx {
 
+/* The value of a load operand of an instruction run by execute_fast */
+#define FastOperand(dec, ix)   \
+	((dec)->modes[ix] == decmode_Locals ? Stk4((dec)->args[ix].value + localsbase) : (dec)->args[ix].value)
+
+/* Store a value to the local given by a store operand */
+#define FastStore(dec, ix, vl)   \
+	StkW4((dec)->args[ix].value + localsbase, (vl))
+
+void Glulx::execute_fast(const decodedinst_t *dec) {
+	switch (dec->opcode) {
+	case op_add:
+		FastStore(dec, 2, FastOperand(dec, 0) + FastOperand(dec, 1));
+		break;
+	case op_sub:
+		FastStore(dec, 2, FastOperand(dec, 0) - FastOperand(dec, 1));
+		break;
+	case op_copy:
+		FastStore(dec, 1, FastOperand(dec, 0));
+		break;
+	case op_aload:
+		FastStore(dec, 2, Mem4(FastOperand(dec, 0) + 4 * FastOperand(dec, 1)));
+		break;
+
+	/* The branch offsets are never 0 or 1 here, see decode_instruction */
+	case op_jump:
+		pc = (pc + dec->args[0].value - 2);
+		break;
+	case op_jz:
+		if (FastOperand(dec, 0) == 0)
+			pc = (pc + dec->args[1].value - 2);
+		break;
+	case op_jnz:
+		if (FastOperand(dec, 0) != 0)
+			pc = (pc + dec->args[1].value - 2);
+		break;
+	case op_jeq:
+		if (FastOperand(dec, 0) == FastOperand(dec, 1))
+			pc = (pc + dec->args[2].value - 2);
+		break;
+	case op_jne:
+		if (FastOperand(dec, 0) != FastOperand(dec, 1))
+			pc = (pc + dec->args[2].value - 2);
+		break;
+	case op_jlt:
+		if ((int)FastOperand(dec, 0) < (int)FastOperand(dec, 1))
+			pc = (pc + dec->args[2].value - 2);
+		break;
+	case op_jge:
+		if ((int)FastOperand(dec, 0) >= (int)FastOperand(dec, 1))
+			pc = (pc + dec->args[2].value - 2);
+		break;
+	case op_jgt:
+		if ((int)FastOperand(dec, 0) > (int)FastOperand(dec, 1))
+			pc = (pc + dec->args[2].value - 2);
+		break;
+	case op_jle:
+		if ((int)FastOperand(dec, 0) <= (int)FastOperand(dec, 1))
+			pc = (pc + dec->args[2].value - 2);
+		break;
+
+	default:
+		fatal_error_i("Executed unknown opcode.", dec->opcode);
+	}
+}
+
+#undef FastOperand
+#undef FastStore
+
 void Glulx::execute_loop() {
 	bool done_executing = false;
 	int ix;
 	uint opcode;
-	const operandlist_t *oplist;
+	const decodedinst_t *dec;
+	decodedinst_t decscratch;
 	oparg_t inst[MAX_OPERANDS];
 	uint value, addr, val0, val1;
 	int vals0, vals1;
@@ -49,44 +118,24 @@ void Glulx::execute_loop() {
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
 
-		/* Fetch the opcode number. */
-		opcode = Mem1(pc);
-		pc++;
-		if (opcode & 0x80) {
-			/* More than one-byte opcode. */
-			if (opcode & 0x40) {
-				/* Four-byte opcode */
-				opcode &= 0x3F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			} else {
-				/* Two-byte opcode */
-				opcode &= 0x7F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			}
-		}
+		/* Decode the instruction, or find it in the decoded instruction
+		   cache. This gives the opcode number, and the structure that
+		   describes how the operands for this opcode are arranged. */
+		dec = fetch_instruction(&decscratch);
+		opcode = dec->opcode;
 
-		/* Now we have an opcode number. */
+		/* Move the PC up to the end of the instruction. */
+		pc = dec->nextpc;
 
-		/* Fetch the structure that describes how the operands for this
-		   opcode are arranged. This is a pointer to an immutable,
-		   static object. */
-		if (opcode < 0x80)
-			oplist = fast_operandlist[opcode];
-		else
-			oplist = lookup_operandlist(opcode);
-
-		if (!oplist)
-			fatal_error_i("Encountered unknown opcode.", opcode);
+		/* The most common instructions on constants and locals have a
+		   shorter path. */
+		if (dec->fast) {
+			execute_fast(dec);
+			continue;
+		}
 
-		/* Based on the oplist structure, load the actual operand values
-		   into inst. This moves the PC up to the end of the instruction. */
-		parse_operands(inst, oplist);
+		/* Load the actual operand values into inst. */
+		load_operands(inst, dec);
 
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
@@ -429,7 +429,10 @@ void Glulx::parse_glk_args(dispatch_splot_t *splot, const char **proto, int dept
 						nonfatal_warning_i("Memory access was much too long -- perhaps a print_to_array call with only one argument", varglist[ix + 1]);
 						varglist[ix + 1] = endmem - varglist[ix];
 					}
-					verify_array_addresses(varglist[ix], varglist[ix + 1], 1);
+					if (passout)
+						verify_array_addresses_write(varglist[ix], varglist[ix + 1], 1);
+					else
+						verify_array_addresses(varglist[ix], varglist[ix + 1], 1);
 					garglist[gargnum]._array = CaptureCArray(varglist[ix], varglist[ix + 1], passin);
 					gargnum++;
 					ix++;
@@ -444,7 +447,10 @@ void Glulx::parse_glk_args(dispatch_splot_t *splot, const char **proto, int dept
 						nonfatal_warning_i("Memory access was much too long -- perhaps a print_to_array call with only one argument", varglist[ix + 1]);
 						varglist[ix + 1] = (endmem - varglist[ix]) / 4;
 					}
-					verify_array_addresses(varglist[ix], varglist[ix + 1], 4);
+					if (passout)
+						verify_array_addresses_write(varglist[ix], varglist[ix + 1], 4);
+					else
+						verify_array_addresses(varglist[ix], varglist[ix + 1], 4);
 					garglist[gargnum]._array = CaptureIArray(varglist[ix], varglist[ix + 1], passin);
 					gargnum++;
 					ix++;
@@ -456,7 +462,10 @@ void Glulx::parse_glk_args(dispatch_splot_t *splot, const char **proto, int dept
 					/* This case was added after the giant arrays were deprecated,
 					   so we don't bother to allow for that case. We just verify
 					   the length. */
-					verify_array_addresses(varglist[ix], varglist[ix + 1], 4);
+					if (passout)
+						verify_array_addresses_write(varglist[ix], varglist[ix + 1], 4);
+					else
+						verify_array_addresses(varglist[ix], varglist[ix + 1], 4);
 					garglist[gargnum]._array = CapturePtrArray(varglist[ix], varglist[ix + 1], (*cx - 'a'), passin);
 					gargnum++;
 					ix++;
@@ -1263,6 +1272,8 @@ gidispatch_rock_t Glulx::glulxe_array_restore(long bufkey, uint len, char *typec
 		elemsize = 4;
 
 	if (!elemsize) {
+		/* The library gets direct access to the memory map, and may write to it */
+		verify_array_addresses_write(bufkey, len, 1);
 		unsigned char *buf = memmap + bufkey;
 		*arrayref = buf;
 		rock.ptr = nullptr;
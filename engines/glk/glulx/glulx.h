@@ -146,6 +146,12 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Cache of decoded instructions, indexed by address. Only instructions in ROM are cached,
+	 * as ROM can't be written to.
+	 */
+	decodedinst_t *decodecache;
+
 	/**@}*/
 
 	/**
@@ -513,6 +519,12 @@ public:
 	 */
 	void verify_array_addresses(uint addr, uint count, uint size);
 
+	/**
+	 * Like verify_array_addresses, for an array which will be written to. Writing to ROM is
+	 * not allowed, as it could change code which has already been decoded.
+	 */
+	void verify_array_addresses_write(uint addr, uint count, uint size);
+
 	/**@}*/
 
 	/**
@@ -525,6 +537,13 @@ public:
 	 */
 	void execute_loop();
 
+	/**
+	 * Execute one of the most common instructions, when all its operands are constants or
+	 * locals and it stores to a local. This skips the generic operand loading and storing.
+	 * The PC must already be at the next instruction.
+	 */
+	void execute_fast(const decodedinst_t *dec);
+
 	/**@}*/
 
 	/**
@@ -537,6 +556,11 @@ public:
 	 */
 	void init_operands();
 
+	/**
+	 * Free the decoded instruction cache. This is called when the VM shuts down.
+	 */
+	void final_operands();
+
 	/**
 	 * Return the operandlist for a given opcode. For opcodes in the range 00..7F, it's faster
 	 * to use the array fast_operandlist[].
@@ -544,13 +568,23 @@ public:
 	const operandlist_t *lookup_operandlist(uint opcode);
 
 	/**
-	 * Read the list of operands of an instruction, and put the values in args. This assumes
-	 * that the PC is at the beginning of the operand mode list (right after an opcode number.)
-	 * Upon return, the PC will be at the beginning of the next instruction.
-	 *
-	 * This also assumes that args points at an allocated array of MAX_OPERANDS oparg_t structures.
-	*/
-	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
+	 * Decode the instruction at the given address: its opcode, its operandlist, and the addressing
+	 * mode and constant part of each operand. This reads only the instruction itself, not any
+	 * memory or stack values the operands refer to.
+	 */
+	void decode_instruction(decodedinst_t *dec, uint addr);
+
+	/**
+	 * Return the decoded instruction at the PC. Instructions in ROM are looked up in the
+	 * decoded instruction cache; anything else is decoded into the provided scratch entry.
+	 */
+	const decodedinst_t *fetch_instruction(decodedinst_t *scratch);
+
+	/**
+	 * Load the operand values of a decoded instruction into args. This pops stack operands,
+	 * so it must be called exactly once each time the instruction is executed.
+	 */
+	void load_operands(oparg_t *args, const decodedinst_t *dec);
 
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
@@ -352,6 +352,39 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How a decoded operand gets its value when the instruction is executed.
+ */
+enum decodedmode {
+	decmode_Constant = 0,   ///< The value is a constant
+	decmode_Stack = 1,      ///< The value is popped off the stack
+	decmode_Memory = 2,     ///< The value is read from the main memory address in value
+	decmode_Locals = 3,     ///< The value is read from the locals offset in value
+	decmode_Store = 4       ///< A store operand; desttype and value are final
+};
+
+/**
+ * An instruction whose opcode and operand addressing modes have been decoded. Only the
+ * operands which depend on the machine state are left to be read at execution time.
+ */
+struct decodedinst_struct {
+	uint pc;                    ///< Address of the instruction, or DECODED_EMPTY for unused cache entries
+	uint opcode;
+	uint nextpc;                ///< Address of the instruction following this one
+	const operandlist_t *oplist;
+	bool fast;                  ///< Whether execute_fast can run this instruction
+	byte modes[MAX_OPERANDS];   ///< One of the decodedmode values for each operand
+	oparg_t args[MAX_OPERANDS];
+};
+typedef decodedinst_struct decodedinst_t;
+
+#define DECODED_EMPTY (0xFFFFFFFF)
+
+/**
+ * Number of entries in the decoded instruction cache. This must be a power of two.
+ */
+#define DECODECACHE_SIZE (0x2000)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -67,6 +67,22 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	/* The cache is only an optimization. If it can't be allocated,
+	   every instruction is decoded as it's executed. */
+	if (!decodecache)
+		decodecache = (decodedinst_t *)glulx_malloc(sizeof(decodedinst_t) * DECODECACHE_SIZE);
+	if (decodecache) {
+		for (int ix = 0; ix < DECODECACHE_SIZE; ix++)
+			decodecache[ix].pc = DECODED_EMPTY;
+	}
+}
+
+void Glulx::final_operands() {
+	if (decodecache) {
+		glulx_free(decodecache);
+		decodecache = nullptr;
+	}
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -280,20 +296,60 @@ const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 	}
 }
 
-void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
+void Glulx::decode_instruction(decodedinst_t *dec, uint addr) {
+	uint opcode;
+	const operandlist_t *oplist;
 	int ix;
-	oparg_t *curarg;
-	int numops = oplist->num_ops;
-	int argsize = oplist->arg_size;
-	uint modeaddr = pc;
+	int numops;
+	uint modeaddr;
 	int modeval = 0;
+	const uint startaddr = addr;
+
+	/* Fetch the opcode number. */
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		} else {
+			/* Two-byte opcode */
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
 
-	pc += (numops + 1) / 2;
+	/* Fetch the structure that describes how the operands for this
+	   opcode are arranged. This is a pointer to an immutable,
+	   static object. */
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	dec->opcode = opcode;
+	dec->oplist = oplist;
+
+	numops = oplist->num_ops;
+	modeaddr = addr;
+	addr += (numops + 1) / 2;
+
+	for (ix = 0; ix < numops; ix++) {
 		int mode;
-		uint value;
-		uint addr;
+		uint value = 0;
+		byte *decmode = &dec->modes[ix];
+		oparg_t *curarg = &dec->args[ix];
 
 		curarg->desttype = 0;
 
@@ -305,203 +361,118 @@ void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 			modeaddr++;
 		}
 
-		if (oplist->formlist[ix] == modeform_Load) {
+		/* Read the constant part of the operand. Modes 1, 5, 9 and 13
+		   have one byte; 2, 6, 10 and 14 two; 3, 7, 11 and 15 four. */
+		switch (mode) {
+		case 1: /* one-byte constant */
+			/* Sign-extend from 8 bits to 32 */
+			value = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+
+		case 2: /* two-byte constant */
+			/* Sign-extend the first byte from 8 bits to 32; the subsequent
+			   byte must not be sign-extended. */
+			value = (int)(signed char)(Mem1(addr));
+			value = (value << 8) | (uint)(Mem1(addr + 1));
+			addr += 2;
+			break;
+
+		case 5:
+		case 9:
+		case 13:
+			value = (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 6:
+		case 10:
+		case 14:
+			value = (uint)Mem2(addr);
+			addr += 2;
+			break;
+
+		case 3:
+		case 7:
+		case 11:
+		case 15:
+			/* Bytes must not be sign-extended. */
+			value = Mem4(addr);
+			addr += 4;
+			break;
+
+		default:
+			break;
+		}
 
-			switch (mode) {
-
-			case 8: /* pop off stack */
-				if (stackptr < valstackbase + 4) {
-					fatal_error("Stack underflow in operand.");
-				}
-				stackptr -= 4;
-				value = Stk4(stackptr);
-				break;
+		/* Addresses in modes 13 to 15 are relative to the start of RAM. */
+		if (mode >= 13)
+			value += ramstart;
 
+		if (oplist->formlist[ix] == modeform_Load) {
+			switch (mode) {
 			case 0: /* constant zero */
-				value = 0;
-				break;
-
 			case 1: /* one-byte constant */
-				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				break;
-
 			case 2: /* two-byte constant */
-				/* Sign-extend the first byte from 8 bits to 32; the subsequent
-				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
-				break;
-
 			case 3: /* four-byte constant */
-				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
+				*decmode = decmode_Constant;
 				break;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
+			case 8: /* pop off stack */
+				*decmode = decmode_Stack;
+				break;
 
 			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
-				if (argsize == 4) {
-					value = Mem4(addr);
-				} else if (argsize == 2) {
-					value = Mem2(addr);
-				} else {
-					value = Mem1(addr);
-				}
+			case 6: /* main memory, two-byte address */
+			case 7: /* main memory, four-byte address */
+			case 13: /* main memory RAM, one-byte address */
+			case 14: /* main memory RAM, two-byte address */
+			case 15: /* main memory RAM, four-byte address */
+				*decmode = decmode_Memory;
 				break;
 
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
-
 			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				addr += localsbase;
-				if (argsize == 4) {
-					value = Stk4(addr);
-				} else if (argsize == 2) {
-					value = Stk2(addr);
-				} else {
-					value = Stk1(addr);
-				}
+			case 10: /* locals, two-byte address */
+			case 11: /* locals, four-byte address */
+				/* It's illegal for addr to not be four-byte aligned, but we don't
+				   check this explicitly. A "strict mode" interpreter probably should.
+				   It's also illegal for addr to be less than zero or greater than
+				   the size of the locals segment. */
+				*decmode = decmode_Locals;
 				break;
 
 			default:
-				value = 0;
 				fatal_error("Unknown addressing mode in load operand.");
 			}
 
-			curarg->value = value;
-
 		} else { /* modeform_Store */
-			switch (mode) {
+			*decmode = decmode_Store;
 
+			switch (mode) {
 			case 0: /* discard value */
 				curarg->desttype = 0;
-				curarg->value = 0;
 				break;
 
 			case 8: /* push on stack */
 				curarg->desttype = 3;
-				curarg->value = 0;
 				break;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto WrMainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrMainMemAddr;
-
 			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrMainMemAddr:
-				/* cases 5, 6, 7 all wind up here. */
+			case 6: /* main memory, two-byte address */
+			case 7: /* main memory, four-byte address */
+			case 13: /* main memory RAM, one-byte address */
+			case 14: /* main memory RAM, two-byte address */
+			case 15: /* main memory RAM, four-byte address */
 				curarg->desttype = 1;
-				curarg->value = addr;
 				break;
 
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrLocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrLocalsAddr;
-
 			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrLocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				curarg->desttype = 2;
+			case 10: /* locals, two-byte address */
+			case 11: /* locals, four-byte address */
 				/* We don't add localsbase here; the store address for desttype 2
 				   is relative to the current locals segment, not an absolute
 				   stack position. */
-				curarg->value = addr;
+				curarg->desttype = 2;
 				break;
 
 			case 1:
@@ -514,6 +485,116 @@ WrLocalsAddr:
 				fatal_error("Unknown addressing mode in store operand.");
 			}
 		}
+
+		curarg->value = value;
+	}
+
+	/* Check whether execute_fast can run the instruction: all load operands
+	   must be constants or locals, the store operand a local, and a branch
+	   offset a constant which doesn't return from the function. */
+	dec->fast = false;
+	switch (opcode) {
+	case op_add:
+	case op_sub:
+	case op_copy:
+	case op_aload:
+	case op_jump:
+	case op_jz:
+	case op_jnz:
+	case op_jeq:
+	case op_jne:
+	case op_jlt:
+	case op_jge:
+	case op_jgt:
+	case op_jle:
+		dec->fast = true;
+		for (ix = 0; ix < numops; ix++) {
+			if (dec->modes[ix] == decmode_Store) {
+				if (dec->args[ix].desttype != 2)
+					dec->fast = false;
+			} else if (dec->modes[ix] != decmode_Constant && dec->modes[ix] != decmode_Locals) {
+				dec->fast = false;
+			}
+		}
+		if (opcode == op_jump || (opcode >= op_jz && opcode <= op_jle)) {
+			const int last = numops - 1;
+			if (dec->modes[last] != decmode_Constant || dec->args[last].value == 0 || dec->args[last].value == 1)
+				dec->fast = false;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	dec->pc = startaddr;
+	dec->nextpc = addr;
+}
+
+const decodedinst_t *Glulx::fetch_instruction(decodedinst_t *scratch) {
+	/* Instructions in ROM never change, since writing to ROM is a fatal
+	   error. Code in RAM may be modified, so it's decoded every time. */
+	if (decodecache && pc < ramstart) {
+		decodedinst_t *dec = &decodecache[pc & (DECODECACHE_SIZE - 1)];
+		if (dec->pc != pc) {
+			decode_instruction(dec, pc);
+			/* Don't keep an instruction whose operands reach into RAM */
+			if (dec->nextpc > ramstart) {
+				*scratch = *dec;
+				dec->pc = DECODED_EMPTY;
+				return scratch;
+			}
+		}
+		return dec;
+	}
+
+	decode_instruction(scratch, pc);
+	return scratch;
+}
+
+void Glulx::load_operands(oparg_t *args, const decodedinst_t *dec) {
+	int numops = dec->oplist->num_ops;
+	int argsize = dec->oplist->arg_size;
+	uint addr;
+
+	for (int ix = 0; ix < numops; ix++) {
+		args[ix] = dec->args[ix];
+
+		switch (dec->modes[ix]) {
+		case decmode_Stack:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			args[ix].value = Stk4(stackptr);
+			break;
+
+		case decmode_Memory:
+			addr = args[ix].value;
+			if (argsize == 4) {
+				args[ix].value = Mem4(addr);
+			} else if (argsize == 2) {
+				args[ix].value = Mem2(addr);
+			} else {
+				args[ix].value = Mem1(addr);
+			}
+			break;
+
+		case decmode_Locals:
+			addr = args[ix].value + localsbase;
+			if (argsize == 4) {
+				args[ix].value = Stk4(addr);
+			} else if (argsize == 2) {
+				args[ix].value = Stk2(addr);
+			} else {
+				args[ix].value = Stk1(addr);
+			}
+			break;
+
+		default:
+			/* Constants and store operands are complete already. */
+			break;
+		}
 	}
 }
 
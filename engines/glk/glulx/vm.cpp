@@ -116,6 +116,7 @@ void Glulx::finalize_vm() {
 		stack = nullptr;
 	}
 
+	final_operands();
 	final_serial();
 }
 
@@ -313,5 +314,11 @@ void Glulx::verify_array_addresses(uint addr, uint count, uint size) {
 		fatal_error_i("Memory access too long", addr);
 }
 
+void Glulx::verify_array_addresses_write(uint addr, uint count, uint size) {
+	verify_array_addresses(addr, count, size);
+	if (count && addr < ramstart)
+		fatal_error_i("Memory write to read-only address", addr);
+}
+
 } // End of namespace Glulx
 } // End of namespace Glk
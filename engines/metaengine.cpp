@@ -272,32 +272,56 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 
 	filenames = saveFileMan->listSavefiles(pattern);
 
+	// Only the headers of the files listed now are kept, so that the cache
+	// does not grow with files which were removed or belong to other targets.
+	SaveHeaderCache headers;
+
 	SaveStateList saveList;
 	for (Common::StringArray::const_iterator file = filenames.begin(); file != filenames.end(); ++file) {
 		// Obtain the last 2 digits of the filename, since they correspond to the save slot
 		int slotNum = atoi(file->c_str() + file->size() - 2);
 
 		if (slotNum >= 0 && slotNum <= getMaximumSaveSlot()) {
-			Common::ScopedPtr<Common::InSaveFile> in(saveFileMan->openForLoading(*file));
-			if (in) {
-				ExtendedSavegameHeader header;
-				if (!readSavegameHeader(in.get(), &header)) {
+			// Reuse the header read previously if the file did not change since
+			uint32 size = 0, modificationTime = 0;
+			const bool hasInfo = saveFileMan->getSavefileInfo(*file, size, modificationTime);
+			SaveHeaderCache::const_iterator cached = _saveHeaderCache.find(*file);
+
+			CachedSaveHeader entry;
+			if (hasInfo && cached != _saveHeaderCache.end() &&
+			    cached->_value.size == size && cached->_value.modificationTime == modificationTime) {
+				entry = cached->_value;
+			} else {
+				Common::ScopedPtr<Common::InSaveFile> in(saveFileMan->openForLoading(*file));
+				if (!in)
 					continue;
-				}
 
-				SaveStateDescriptor desc;
+				ExtendedSavegameHeader header;
+				entry.size = size;
+				entry.modificationTime = modificationTime;
+				entry.valid = readSavegameHeader(in.get(), &header);
+				if (entry.valid)
+					parseSavegameHeader(&header, &entry.desc);
+			}
+
+			if (hasInfo)
+				headers[*file] = entry;
 
-				parseSavegameHeader(&header, &desc);
+			if (!entry.valid)
+				continue;
 
-				desc.setSaveSlot(slotNum);
-				if (slotNum == getAutosaveSlot())
-					desc.setWriteProtectedFlag(true);
+			SaveStateDescriptor desc = entry.desc;
 
-				saveList.push_back(desc);
-			}
+			desc.setSaveSlot(slotNum);
+			if (slotNum == getAutosaveSlot())
+				desc.setWriteProtectedFlag(true);
+
+			saveList.push_back(desc);
 		}
 	}
 
+	_saveHeaderCache = headers;
+
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
 	return saveList;
@@ -27,6 +27,8 @@
 #include "common/scummsys.h"
 #include "common/error.h"
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 
 #include "engines/game.h"
 #include "engines/savestate.h"
@@ -531,6 +533,25 @@ public:
 	 * Read the extended savegame header from the given savegame file.
 	 */
 	static WARN_UNUSED_RESULT bool readSavegameHeader(Common::InSaveFile *in, ExtendedSavegameHeader *header, bool skipThumbnail = true);
+
+private:
+	struct CachedSaveHeader {
+		uint32 size;              /*!< Size of the save file when it was read. */
+		uint32 modificationTime;  /*!< Modification time of the save file when it was read. */
+		bool valid;               /*!< Whether the save file has a valid extended header. */
+		SaveStateDescriptor desc; /*!< Descriptor of the save, without its slot information. */
+	};
+
+	typedef Common::HashMap<Common::String, CachedSaveHeader, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveHeaderCache;
+
+	/**
+	 * Extended headers of the save files read by the default listSaves()
+	 * implementation. Compressed save files must be decompressed entirely
+	 * to reach the header, so the headers are kept until the size or the
+	 * modification time of the file change. Only the files found by the
+	 * last listing are kept.
+	 */
+	mutable SaveHeaderCache _saveHeaderCache;
 };
 
 /**
@@ -0,0 +1,181 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the AUTHORS
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/myst3/database.h"
+#include "engines/myst3/facecache.h"
+#include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
+
+#include "common/debug.h"
+
+#include "graphics/surface.h"
+
+namespace Myst3 {
+
+// Script opcodes moving the player to another node of the same room
+enum NavigationOpcode {
+	kOpChooseNextNode     = 135,
+	kOpGoToNodeTransition = 136,
+	kOpGoToNodeTrans2     = 137,
+	kOpGoToNodeTrans1     = 138,
+	kOpZipToNode          = 140
+};
+
+FaceCache::FaceCache(Myst3Engine *vm) :
+		_vm(vm),
+		_hits(0),
+		_misses(0) {
+}
+
+FaceCache::~FaceCache() {
+	clear();
+}
+
+void FaceCache::clear() {
+	for (Common::List<Entry>::iterator it = _entries.begin(); it != _entries.end(); it++) {
+		it->bitmap->free();
+		delete it->bitmap;
+	}
+
+	_entries.clear();
+	_pending.clear();
+}
+
+FaceCache::FaceKey FaceCache::currentRoomKey(uint16 nodeID, uint16 face) const {
+	FaceKey key;
+	key.room = _vm->_db->getRoomName(_vm->_state->getLocationRoom(), _vm->_state->getLocationAge());
+	key.node = nodeID;
+	key.face = face;
+	return key;
+}
+
+bool FaceCache::isCached(const FaceKey &key) const {
+	for (Common::List<Entry>::const_iterator it = _entries.begin(); it != _entries.end(); it++) {
+		if (it->key == key)
+			return true;
+	}
+
+	return false;
+}
+
+Graphics::Surface *FaceCache::takeFace(uint16 nodeID, uint16 face, const ResourceDescription *jpegDesc) {
+	FaceKey key = currentRoomKey(nodeID, face);
+
+	for (Common::List<Entry>::iterator it = _entries.begin(); it != _entries.end(); it++) {
+		if (it->key == key) {
+			Graphics::Surface *bitmap = it->bitmap;
+			_entries.erase(it);
+			_hits++;
+			return bitmap;
+		}
+	}
+
+	_misses++;
+	return Myst3Engine::decodeJpeg(jpegDesc);
+}
+
+void FaceCache::addNeighbour(Common::Array<uint16> &nodes, uint16 currentNode, int16 node) const {
+	uint16 nodeID = _vm->_state->valueOrVarValue(node);
+	if (!nodeID || nodeID == currentNode)
+		return;
+
+	for (uint i = 0; i < nodes.size(); i++) {
+		if (nodes[i] == nodeID)
+			return;
+	}
+
+	nodes.push_back(nodeID);
+}
+
+void FaceCache::prefetchNeighbours(uint16 nodeID, NodePtr nodeData) {
+	_pending.clear();
+
+	if (!nodeData)
+		return;
+
+	// Look for the nodes the hotspot scripts can lead to
+	Common::Array<uint16> nodes;
+	for (uint i = 0; i < nodeData->hotspots.size(); i++) {
+		const Common::Array<Opcode> &script = nodeData->hotspots[i].script;
+
+		for (uint j = 0; j < script.size(); j++) {
+			const Opcode &opcode = script[j];
+
+			switch (opcode.op) {
+			case kOpChooseNextNode:
+				if (opcode.args.size() >= 3) {
+					addNeighbour(nodes, nodeID, opcode.args[1]);
+					addNeighbour(nodes, nodeID, opcode.args[2]);
+				}
+				break;
+			case kOpGoToNodeTransition:
+			case kOpGoToNodeTrans2:
+			case kOpGoToNodeTrans1:
+			case kOpZipToNode:
+				if (opcode.args.size() >= 1)
+					addNeighbour(nodes, nodeID, opcode.args[0]);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	for (uint i = 0; i < nodes.size() && _pending.size() < kMaxFaces; i++) {
+		for (uint16 face = 0; face < 6; face++) {
+			FaceKey key = currentRoomKey(nodes[i], face);
+			if (!isCached(key))
+				_pending.push_back(key);
+		}
+	}
+
+	debugC(kDebugNode, "Prefetching %d faces from %d nodes next to node %d", _pending.size(), nodes.size(), nodeID);
+}
+
+bool FaceCache::decodeNext() {
+	if (_pending.empty())
+		return false;
+
+	FaceKey key = _pending.front();
+	_pending.pop_front();
+
+	// Frame nodes have no cube faces, and the room may have changed
+	ResourceDescription jpegDesc = _vm->getFileDescription(key.room, key.node, key.face + 1, Archive::kCubeFace);
+	if (!jpegDesc.isValid() || isCached(key))
+		return true;
+
+	Entry entry;
+	entry.key = key;
+	entry.bitmap = Myst3Engine::decodeJpeg(&jpegDesc);
+	_entries.push_front(entry);
+
+	while (_entries.size() > kMaxFaces) {
+		Entry &oldest = _entries.back();
+		oldest.bitmap->free();
+		delete oldest.bitmap;
+		_entries.pop_back();
+	}
+
+	return true;
+}
+
+} // End of namespace Myst3
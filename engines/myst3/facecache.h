@@ -0,0 +1,114 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the AUTHORS
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef MYST3_FACECACHE_H
+#define MYST3_FACECACHE_H
+
+#include "engines/myst3/archive.h"
+
+#include "common/array.h"
+#include "common/list.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+namespace Graphics {
+struct Surface;
+}
+
+namespace Myst3 {
+
+class Myst3Engine;
+struct NodeData;
+
+typedef Common::SharedPtr<NodeData> NodePtr;
+
+/**
+ * Decoded cube faces of the nodes the player is likely to move to next.
+ *
+ * Decoding the six JPEG faces of a cube node takes long enough to cause
+ * a visible pause when moving to it. While the player looks around a node,
+ * the faces of the nodes its hotspots lead to are decoded one at a time
+ * from the main loop, so that most moves find their faces already decoded.
+ */
+class FaceCache {
+public:
+	FaceCache(Myst3Engine *vm);
+	~FaceCache();
+
+	/**
+	 * Get a decoded cube face, from the cache if it was prefetched.
+	 * The caller takes ownership of the returned surface.
+	 */
+	Graphics::Surface *takeFace(uint16 nodeID, uint16 face, const ResourceDescription *jpegDesc);
+
+	/** Queue the faces of the cube nodes reachable from a node of the current room */
+	void prefetchNeighbours(uint16 nodeID, NodePtr nodeData);
+
+	/**
+	 * Decode one of the queued faces.
+	 *
+	 * @return false if there was nothing left to decode
+	 */
+	bool decodeNext();
+
+	/** Drop all the decoded faces and the queued ones */
+	void clear();
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+
+private:
+	/** At 640x640 RGBA, three full nodes use about 30 MB */
+	static const uint kMaxFaces = 18;
+
+	struct FaceKey {
+		Common::String room;
+		uint16 node;
+		uint16 face;
+
+		bool operator==(const FaceKey &other) const {
+			return node == other.node && face == other.face && room == other.room;
+		}
+	};
+
+	struct Entry {
+		FaceKey key;
+		Graphics::Surface *bitmap;
+	};
+
+	Myst3Engine *_vm;
+
+	/** Decoded faces, most recently decoded first */
+	Common::List<Entry> _entries;
+	Common::List<FaceKey> _pending;
+
+	uint32 _hits;
+	uint32 _misses;
+
+	FaceKey currentRoomKey(uint16 nodeID, uint16 face) const;
+	bool isCached(const FaceKey &key) const;
+	void addNeighbour(Common::Array<uint16> &nodes, uint16 currentNode, int16 node) const;
+};
+
+} // End of namespace Myst3
+
+#endif // MYST3_FACECACHE_H
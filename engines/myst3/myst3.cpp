@@ -38,6 +38,7 @@
 #include "engines/myst3/console.h"
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/nodeframe.h"
@@ -67,7 +68,7 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		_db(0), _scriptEngine(0),
 		_state(0), _node(0), _scene(0), _archiveNode(0),
 		_cursor(0), _inventory(0), _gfx(0), _menu(0),
-		_rnd(0), _sound(0), _ambient(0),
+		_rnd(0), _sound(0), _ambient(0), _faceCache(0),
 		_inputSpacePressed(false), _inputEnterPressed(false),
 		_inputEscapePressed(false), _inputTildePressed(false),
 		_inputEscapePressedNotConsumed(false),
@@ -115,6 +116,7 @@ Myst3Engine::~Myst3Engine() {
 	delete _inventory;
 	delete _cursor;
 	delete _scene;
+	delete _faceCache;
 	delete _archiveNode;
 	delete _db;
 	delete _scriptEngine;
@@ -165,6 +167,7 @@ Common::Error Myst3Engine::run() {
 		_menu = new PagingMenu(this);
 	}
 	_archiveNode = new Archive();
+	_faceCache = new FaceCache(this);
 
 	_system->showMouse(false);
 
@@ -208,6 +211,10 @@ Common::Error Myst3Engine::run() {
 			_menuAction = 0;
 		}
 
+		// Use the time between frames to decode the faces of the nodes
+		// the player may go to next
+		_faceCache->decodeNext();
+
 		drawFrame();
 	}
 
@@ -859,6 +866,11 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 		return; // The main init script does not load a node
 	}
 
+	if (_state->getViewType() == kCube) {
+		uint16 node = _state->getLocationNode();
+		_faceCache->prefetchNeighbours(node, _db->getNodeData(node, _state->getLocationRoom(), _state->getLocationAge()));
+	}
+
 	// The effects can only be created after running the node init scripts
 	_node->initEffects();
 	_shakeEffect = ShakeEffect::create(this);
@@ -21,6 +21,7 @@
  */
 
 #include "engines/myst3/archive.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/myst3.h"
 
@@ -32,6 +33,9 @@ NodeCube::NodeCube(Myst3Engine *vm, uint16 id) :
 		Node(vm, id) {
 	_is3D = true;
 
+	uint32 startTime = g_system->getMillis();
+	uint32 prefetchHits = _vm->_faceCache->getHits();
+
 	for (int i = 0; i < 6; i++) {
 		ResourceDescription jpegDesc = _vm->getFileDescription("", id, i + 1, Archive::kCubeFace);
 
@@ -39,8 +43,11 @@ NodeCube::NodeCube(Myst3Engine *vm, uint16 id) :
 			error("Face %d does not exist", id);
 
 		_faces[i] = new Face(_vm);
-		_faces[i]->setTextureFromJPEG(&jpegDesc);
+		_faces[i]->setTextureFromBitmap(_vm->_faceCache->takeFace(id, i, &jpegDesc));
 	}
+
+	debugC(kDebugNode, "Loaded cube node %d in %d ms, %d faces were prefetched", id,
+	       g_system->getMillis() - startTime, _vm->_faceCache->getHits() - prefetchHits);
 }
 
 NodeCube::~NodeCube() {
@@ -451,7 +451,7 @@ void SmushPlayer::handleIACT(int32 subSize, Common::SeekableReadStream &b) {
 					_IACTpos += bsize;
 					bsize = 0;
 				} else {
-					byte *output_data = (byte *)malloc(4096);
+					byte output_data[4096];
 
 					memcpy(_IACToutput + _IACTpos, d_src, len);
 					byte *dst = output_data;
@@ -483,10 +483,11 @@ void SmushPlayer::handleIACT(int32 subSize, Common::SeekableReadStream &b) {
 					} while (--count);
 
 					if (!_IACTstream) {
-						_IACTstream = Audio::makeQueuingAudioStream(22050, true);
+						// The stream copies each packet, so output_data can be reused
+						_IACTstream = Audio::makePooledQueuingAudioStream(22050, true, 0x1000, 16);
 						_vm->_mixer->playStream(Audio::Mixer::kSFXSoundType, _IACTchannel, _IACTstream);
 					}
-					_IACTstream->queueBuffer(output_data, 0x1000, DisposeAfterUse::YES, Audio::FLAG_STEREO | Audio::FLAG_16BITS);
+					_IACTstream->queueBuffer(output_data, 0x1000, DisposeAfterUse::NO, Audio::FLAG_STEREO | Audio::FLAG_16BITS);
 
 					bsize -= len;
 					d_src += len;
@@ -51,6 +51,10 @@ public:
 		return (_pImage != 0);
 	}
 
+	uint getMemoryUsage() const override {
+		return _pImage ? _pImage->getWidth() * _pImage->getHeight() * 4 : 0;
+	}
+
 	/**
 	    @brief Gibt die Breite des Bitmaps zurück.
 	*/
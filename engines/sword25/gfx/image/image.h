@@ -101,6 +101,8 @@ public:
 	                 The images will be scaled if the output width of the screen section differs from the image section.<br>
 	                 The value -1 determines that the image should not be scaled.<br>
 	                 The default value is -1.
+	    @param updateRects the screen regions which are going to be updated, or NULL.<br>
+	                       Implementations may skip the parts of the image outside of these regions.
 	    @return returns false if the rendering failed.
 	    @remark Not all blitting operations of all BS_Image classes are supported.<br>
 	            More information can be find in the class description of BS_Image and the following methodes:
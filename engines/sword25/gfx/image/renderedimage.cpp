@@ -227,7 +227,29 @@ uint RenderedImage::getPixel(int x, int y) {
 // -----------------------------------------------------------------------------
 
 bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, RectangleList *updateRects) {
-	_surface.blit(*_backSurface, posX, posY, (((flipping & 1) ? Graphics::FLIP_V : 0) | ((flipping & 2) ? Graphics::FLIP_H : 0)), pPartRect, color, width, height);
+	const int flip = ((flipping & 1) ? Graphics::FLIP_V : 0) | ((flipping & 2) ? Graphics::FLIP_H : 0);
+	const Common::Rect srcRect = pPartRect ? *pPartRect : Common::Rect(_surface.w, _surface.h);
+
+	// Scaled images are drawn in one go
+	if (!updateRects || (width != -1 && width != srcRect.width()) || (height != -1 && height != srcRect.height())) {
+		_surface.blit(*_backSurface, posX, posY, flip, pPartRect, color, width, height);
+		return true;
+	}
+
+	// Only draw the parts of the image which are going to be copied to the screen.
+	// The update rectangles don't overlap, so every pixel is blended once.
+	// The part rectangle is given in flipped coordinates, so it can be
+	// offset just like the destination rectangle.
+	const Common::Rect destRect(posX, posY, posX + srcRect.width(), posY + srcRect.height());
+	for (RectangleList::iterator it = updateRects->begin(); it != updateRects->end(); ++it) {
+		if (!destRect.intersects(*it))
+			continue;
+
+		const Common::Rect clipRect = destRect.findIntersectingRect(*it);
+		Common::Rect partRect = clipRect;
+		partRect.translate(srcRect.left - posX, srcRect.top - posY);
+		_surface.blit(*_backSurface, clipRect.left, clipRect.top, flip, &partRect, color);
+	}
 
 	return true;
 }
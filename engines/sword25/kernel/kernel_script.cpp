@@ -251,13 +251,18 @@ static int processMessages(lua_State *L) {
 	// and the game keeps running as true is returned here.
 	// It terminates if we return false.
 
-	// TODO: We could do more stuff here if desired...
-
 	// TODO: We could always return true here, and leave quit handling
 	// to the closeWanted() opcode; see also the TODO comment in there.
 
 	lua_pushbooleancpp(L, !Engine::shouldQuit());
-	g_system->delayMillis(10);
+
+	// Spend the idle time of the frame loading precached resources
+	Kernel *pKernel = Kernel::getInstance();
+	const uint startTime = pKernel->getMilliTicks();
+	pKernel->getResourceManager()->processPrecacheQueue(10);
+	const uint elapsed = pKernel->getMilliTicks() - startTime;
+	if (elapsed < 10)
+		g_system->delayMillis(10 - elapsed);
 
 	return 1;
 }
@@ -310,11 +315,11 @@ static int precacheResource(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-#ifdef PRECACHE_RESOURCES
-	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1)));
-#else
+	// The resource is only loaded when the game is idle, so whether that works
+	// is not known yet. The scripts have always been told that it did, as
+	// precaching was disabled, and missing files are not an error for them.
+	pResource->queuePrecacheResource(luaL_checkstring(L, 1));
 	lua_pushbooleancpp(L, true);
-#endif
 
 	return 1;
 }
@@ -325,11 +330,9 @@ static int forcePrecacheResource(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-#ifdef PRECACHE_RESOURCES
-	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1), true));
-#else
+	// Always report success, as precacheResource() does
+	pResource->queuePrecacheResource(luaL_checkstring(L, 1), true);
 	lua_pushbooleancpp(L, true);
-#endif
 
 	return 1;
 }
@@ -340,9 +343,7 @@ static int getMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This is used for debugging, so it doesn't really matter.
-	// The default value set by the scripts is 256000000 bytes
-	lua_pushnumber(L, 256000000);
+	lua_pushnumber(L, pResource->getMaxMemoryUsage());
 
 	return 1;
 }
@@ -353,8 +354,9 @@ static int setMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This call is ignored, we set a limit on the number of
-	// simultaneous resources loaded instead.
+	// Besides this limit, the number of simultaneously loaded
+	// resources is limited as well.
+	pResource->setMaxMemoryUsage(static_cast<uint>(luaL_checknumber(L, 1)));
 
 	return 0;
 }
@@ -365,6 +367,7 @@ static int emptyCache(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
+	pResource->dumpLoadStatistics();
 	pResource->emptyCache();
 
 	return 0;
@@ -87,7 +87,8 @@ bool ResourceManager::registerResourceService(ResourceService *pService) {
  */
 void ResourceManager::deleteResourcesIfNecessary() {
 	// If enough memory is available, or no resources are loaded, then the function can immediately end
-	if (_resources.size() < SWORD25_RESOURCECACHE_MAX)
+	const bool tooManyResources = _resources.size() >= SWORD25_RESOURCECACHE_MAX;
+	if (_resources.empty() || (!tooManyResources && _usedMemory <= _maxMemoryUsage))
 		return;
 
 	// Keep deleting resources until the memory usage of the process falls below the set maximum limit.
@@ -100,14 +101,15 @@ void ResourceManager::deleteResourcesIfNecessary() {
 		// The resource may be released only if it isn't locked
 		if ((*iter)->getLockCount() == 0)
 			iter = deleteResource(*iter);
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+	} while (iter != _resources.begin() &&
+	         ((tooManyResources && _resources.size() >= SWORD25_RESOURCECACHE_MIN) || _usedMemory > _maxMemoryUsage));
 
 	// Are we still above the minimum? If yes, then start releasing locked resources
 	// FIXME: This code shouldn't be needed at all, but it seems like there is a bug
 	// in the resource lock code, and resources are not unlocked when changing rooms.
 	// Only image/animation resources are unlocked forcibly, thus this shouldn't have
 	// any impact on the game itself.
-	if (_resources.size() <= SWORD25_RESOURCECACHE_MIN)
+	if (!tooManyResources || _resources.size() <= SWORD25_RESOURCECACHE_MIN)
 		return;
 
 	iter = _resources.end();
@@ -133,6 +135,9 @@ void ResourceManager::deleteResourcesIfNecessary() {
  * Releases all resources that are not locked.
  */
 void ResourceManager::emptyCache() {
+	// Pending precache requests would just load the resources back
+	_precacheQueue.clear();
+
 	// Scan through the resource list
 	Common::List<Resource *>::iterator iter = _resources.begin();
 	while (iter != _resources.end()) {
@@ -172,7 +177,9 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	// Determine whether the resource is already loaded
 	// If the resource is found, it will be placed at the head of the resource list and returned
 	Resource *pResource = getResource(uniqueFileName);
-	if (!pResource)
+	if (pResource)
+		++_cacheHits;
+	else
 		pResource = loadResource(uniqueFileName);
 	if (pResource) {
 		moveToFront(pResource);
@@ -220,6 +227,67 @@ bool ResourceManager::precacheResource(const Common::String &fileName, bool forc
 
 #endif
 
+/**
+ * Queues a resource to be loaded into the cache when the game is idle
+ * @param FileName      The filename of the resource to be cached
+ * @param ForceReload   Indicates whether a cached copy of the file should be discarded first
+ * @return              Returns false if the file can't be located
+ */
+bool ResourceManager::queuePrecacheResource(const Common::String &fileName, bool forceReload) {
+	// Get the absolute path to the file
+	Common::String uniqueFileName = getUniqueFileName(fileName);
+	if (uniqueFileName.empty())
+		return false;
+
+	Resource *resourcePtr = getResource(uniqueFileName);
+
+	if (forceReload && resourcePtr) {
+		if (resourcePtr->getLockCount()) {
+			// The locked copy stays valid, there's nothing to reload
+			debugC(kDebugResource, "Could not force precaching of \"%s\". The resource is locked.", fileName.c_str());
+			return true;
+		}
+
+		deleteResource(resourcePtr);
+		resourcePtr = 0;
+	}
+
+	if (resourcePtr)
+		return true;
+
+	PackageManager *pPackage = _kernelPtr->getPackage();
+	if (!pPackage->fileExists(uniqueFileName)) {
+		// This isn't fatal - e.g. it can happen when loading saved games
+		debugC(kDebugResource, "Could not precache \"%s\",", fileName.c_str());
+		return false;
+	}
+
+	_precacheQueue.push_back(uniqueFileName);
+	return true;
+}
+
+/**
+ * Loads queued resources until the given amount of time has been spent
+ * @param maxMillis     The time budget in milliseconds
+ */
+void ResourceManager::processPrecacheQueue(uint maxMillis) {
+	const uint startTime = _kernelPtr->getMilliTicks();
+
+	while (!_precacheQueue.empty() && _kernelPtr->getMilliTicks() - startTime < maxMillis) {
+		// Don't evict anything for the sake of read-ahead. The queue is kept,
+		// as the cache may have room again after the next flush.
+		if (_resources.size() >= SWORD25_RESOURCECACHE_MIN || _usedMemory >= _maxMemoryUsage)
+			return;
+
+		Common::String uniqueFileName = _precacheQueue.front();
+		_precacheQueue.pop_front();
+
+		// The resource may have been requested in the meantime
+		if (!getResource(uniqueFileName) && loadResource(uniqueFileName))
+			++_precacheCount;
+	}
+}
+
 /**
  * Moves a resource to the top of the resource list
  * @param pResource     The resource
@@ -247,11 +315,21 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 			deleteResourcesIfNecessary();
 
 			// Load the resource
+			const uint startTime = _kernelPtr->getMilliTicks();
 			Resource *pResource = _resourceServices[i]->loadResource(fileName);
 			if (!pResource) {
 				error("Responsible service could not load resource \"%s\".", fileName.c_str());
 				return NULL;
 			}
+			const uint loadTime = _kernelPtr->getMilliTicks() - startTime;
+			const uint memoryUsage = pResource->getMemoryUsage();
+
+			debugC(2, kDebugResource, "Loaded \"%s\" (%d bytes) in %d ms", fileName.c_str(), memoryUsage, loadTime);
+
+			_usedMemory += memoryUsage;
+			++_loadCount;
+			_loadMillis += loadTime;
+			_loadBytes += memoryUsage;
 
 			// Add the resource to the front of the list
 			_resources.push_front(pResource);
@@ -296,6 +374,8 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 	// Remove the resource from the hash table
 	_resourceHashMap.erase(pResource->_fileName);
 
+	_usedMemory -= pResource->getMemoryUsage();
+
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
 
@@ -331,4 +411,20 @@ void ResourceManager::dumpLockedResources() {
 	}
 }
 
+/**
+ * Writes the load statistics gathered since the last call to the log file, and resets them
+ */
+void ResourceManager::dumpLoadStatistics() {
+	debugC(kDebugResource, "Loaded %d resources (%d bytes) in %d ms, %d of them ahead of time. %d cache hits",
+	       _loadCount, _loadBytes, _loadMillis, _precacheCount, _cacheHits);
+	debugC(kDebugResource, "%d resources (%d bytes) cached, %d queued for precaching",
+	       _resources.size(), _usedMemory, _precacheQueue.size());
+
+	_loadCount = 0;
+	_loadMillis = 0;
+	_loadBytes = 0;
+	_cacheHits = 0;
+	_precacheCount = 0;
+}
+
 } // End of namespace Sword25
@@ -42,6 +42,10 @@ namespace Sword25 {
 
 //#define PRECACHE_RESOURCES
 
+// The default memory budget of the resource cache, in bytes.
+// This is the value the scripts pass to Resource.SetMaxMemoryUsage().
+#define SWORD25_RESOURCECACHE_MEMORY 256000000
+
 class ResourceService;
 class Resource;
 class Kernel;
@@ -66,6 +70,43 @@ public:
 	bool precacheResource(const Common::String &fileName, bool forceReload = false);
 #endif
 
+	/**
+	 * Queues a resource to be loaded into the cache when the game is idle
+	 * @param FileName      The filename of the resource to be cached
+	 * @param ForceReload   Indicates whether a cached copy of the file should be discarded first
+	 * @return              Returns false if the file can't be located
+	 */
+	bool queuePrecacheResource(const Common::String &fileName, bool forceReload = false);
+
+	/**
+	 * Loads queued resources until the given amount of time has been spent.
+	 * Queued resources are skipped while the cache is full, so that read-ahead
+	 * never pushes out resources which are in use.
+	 * @param maxMillis     The time budget in milliseconds
+	 */
+	void processPrecacheQueue(uint maxMillis);
+
+	/**
+	 * Returns the memory budget of the resource cache in bytes
+	 */
+	uint getMaxMemoryUsage() const {
+		return _maxMemoryUsage;
+	}
+
+	/**
+	 * Sets the memory budget of the resource cache in bytes
+	 */
+	void setMaxMemoryUsage(uint maxMemoryUsage) {
+		_maxMemoryUsage = maxMemoryUsage;
+	}
+
+	/**
+	 * Returns the approximate number of bytes used by the cached resources
+	 */
+	uint getUsedMemory() const {
+		return _usedMemory;
+	}
+
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
 	 * BS_ResourceService, and thus helps all resource services in the ResourceManager list
@@ -88,13 +129,27 @@ public:
 	 */
 	void dumpLockedResources();
 
+	/**
+	 * Writes the load statistics gathered since the last call to the log file,
+	 * and resets them. The scripts empty the cache between scenes, so this
+	 * is called from there to get per-scene figures.
+	 */
+	void dumpLoadStatistics();
+
 private:
 	/**
 	 * Creates a new resource manager
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
 	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
+		_kernelPtr(pKernel),
+		_usedMemory(0),
+		_maxMemoryUsage(SWORD25_RESOURCECACHE_MEMORY),
+		_loadCount(0),
+		_loadMillis(0),
+		_loadBytes(0),
+		_cacheHits(0),
+		_precacheCount(0)
 	{}
 	virtual ~ResourceManager();
 
@@ -139,6 +194,17 @@ private:
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+	Common::List<Common::String> _precacheQueue;
+
+	uint _usedMemory;
+	uint _maxMemoryUsage;
+
+	// Load statistics, see dumpLoadStatistics()
+	uint _loadCount;
+	uint _loadMillis;
+	uint _loadBytes;
+	uint _cacheHits;
+	uint _precacheCount;
 };
 
 } // End of namespace Sword25
@@ -590,14 +590,18 @@ void ToucheEngine::res_loadSound(int priority, int num) {
 	if (priority >= 0) {
 		uint32 size;
 		const uint32 offs = res_getDataOffset(kResourceTypeSound, num, &size);
-		Common::SeekableReadStream *datastream = SearchMan.createReadStreamForMember("TOUCHE.DAT");
-		if (!datastream) {
-			warning("res_loadSound: Could not open TOUCHE.DAT");
-			return;
-		}
+		// Effects are replayed often, so keep them decoded
+		Audio::SeekableAudioStream *stream = _sfxCache.get("", "TOUCHE.DAT", offs);
+		if (!stream) {
+			Common::SeekableReadStream *datastream = SearchMan.createReadStreamForMember("TOUCHE.DAT");
+			if (!datastream) {
+				warning("res_loadSound: Could not open TOUCHE.DAT");
+				return;
+			}
 
-		datastream->seek(offs);
-		Audio::AudioStream *stream = Audio::makeVOCStream(datastream, Audio::FLAG_UNSIGNED, DisposeAfterUse::YES);
+			datastream->seek(offs);
+			stream = _sfxCache.add("", "TOUCHE.DAT", offs, Audio::makeVOCStream(datastream, Audio::FLAG_UNSIGNED, DisposeAfterUse::YES));
+		}
 		if (stream) {
 			_mixer->playStream(Audio::Mixer::kSFXSoundType, &_sfxHandle, stream);
 		}
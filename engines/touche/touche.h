@@ -31,6 +31,7 @@
 #include "common/util.h"
 
 #include "audio/mixer.h"
+#include "audio/soundcache.h"
 
 #include "engines/engine.h"
 
@@ -786,6 +787,7 @@ protected:
 	bool _speechPlaying;
 	Audio::SoundHandle _sfxHandle;
 	Audio::SoundHandle _speechHandle;
+	Audio::SoundCache _sfxCache;
 
 	int16 _inventoryList1[101];
 	int16 _inventoryList2[101];
@@ -28,8 +28,21 @@
 namespace Ultima {
 namespace Nuvie {
 
+/* Hash key of a node location. */
+static inline uint32 node_key(const MapCoord &loc) {
+	return ((uint32)loc.z << 24) | ((uint32)(loc.y & 0xfff) << 12) | (loc.x & 0xfff);
+}
+
 AStarPath::AStarPath() : final_node(0) {
-} void AStarPath::create_path() {
+}
+
+AStarPath::~AStarPath() {
+	delete_nodes();
+	for (uint32 i = 0; i < free_nodes.size(); i++)
+		delete free_nodes[i];
+}
+
+void AStarPath::create_path() {
 	astar_node *i = final_node; // iterator through steps, from back
 	delete_path();
 	Std::vector<astar_node *> reverse_list;
@@ -43,56 +56,44 @@ AStarPath::AStarPath() : final_node(0) {
 		reverse_list.pop_back();
 	}
 	set_path_size(step_count);
-}/* Get a new neighbor to nnode and score it, returning true if it's usable. */
-bool AStarPath::score_to_neighbor(sint8 dir, astar_node *nnode, astar_node *neighbor,
+}/* Get the location of a neighbor to nnode and the cost of stepping to it,
+ * returning true if it's usable. */
+bool AStarPath::score_to_neighbor(sint8 dir, astar_node *nnode, MapCoord &neighbor_loc,
 								  sint32 &nnode_to_neighbor) {
 	sint8 sx = -1, sy = -1;
 	DirFinder::get_adjacent_dir(sx, sy, dir); // sx,sy = neighbor -1,-1 + dir
 	// get neighbor of nnode towards sx,sy, and cost to that neighbor
-	neighbor->loc = nnode->loc.abs_coords(sx, sy);
-	nnode_to_neighbor = step_cost(nnode->loc, neighbor->loc);
-	if (nnode_to_neighbor == -1) {
-		delete neighbor; // this neighbor is blocked
-		return false;
-	}
-	return true;
-}/* Compare a node's score to the start node to already scored neighbors. */
-bool AStarPath::compare_neighbors(astar_node *nnode, astar_node *neighbor,
-								  sint32 nnode_to_neighbor, astar_node *in_open,
-								  astar_node *in_closed) {
-	neighbor->to_start = nnode->to_start + nnode_to_neighbor;
-	// ignore this neighbor if already checked and closer to start
-	if ((in_open && in_open->to_start <= neighbor->to_start)
-	        || (in_closed && in_closed->to_start <= neighbor->to_start)) {
-		delete neighbor;
-		return false;
-	}
-	return true;
+	neighbor_loc = nnode->loc.abs_coords(sx, sy);
+	nnode_to_neighbor = step_cost(nnode->loc, neighbor_loc);
+	return (nnode_to_neighbor != -1); // -1 if this neighbor is blocked
 }/* Check all neighbors of a node (location) and save them to the "seen" list. */
 bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 									  const uint32 max_score) {
 	for (uint32 dir = 1; dir < 8; dir += 2) {
-		astar_node *neighbor = new astar_node;
+		MapCoord neighbor_loc;
 		sint32 nnode_to_neighbor = -1;
-		if (!score_to_neighbor(dir, nnode, neighbor, nnode_to_neighbor))
+		if (!score_to_neighbor(dir, nnode, neighbor_loc, nnode_to_neighbor))
 			continue; // this neighbor is blocked
-		astar_node *in_open = find_open_node(neighbor),
-		            *in_closed = find_closed_node(neighbor);
-		if (!compare_neighbors(nnode, neighbor, nnode_to_neighbor, in_open, in_closed))
+		uint32 to_start = nnode->to_start + nnode_to_neighbor;
+		// ignore this neighbor if already checked and closer to start
+		astar_node *neighbor = find_node(neighbor_loc);
+		if (neighbor && neighbor->to_start <= to_start)
 			continue;
+		uint32 to_goal = path_cost_est(neighbor_loc, goal);
+		if (to_start + to_goal > max_score)
+			continue; // too far away
+		if (!neighbor)
+			neighbor = new_node(neighbor_loc);
 		neighbor->parent = nnode;
-		neighbor->to_goal = path_cost_est(neighbor->loc, goal);
-		neighbor->score = neighbor->to_start + neighbor->to_goal;
+		neighbor->to_start = to_start;
+		neighbor->to_goal = to_goal;
+		neighbor->score = to_start + to_goal;
 		neighbor->len = nnode->len + 1;
-		if (neighbor->score > max_score) {
-			delete neighbor; // too far away
-			continue;
-		}
-		// take neighbor out of closed list and put into open list
-		if (in_closed)
-			remove_closed_node(in_closed);
-		if (!in_open)
+		// a closed neighbor is put back into the open nodes with its new score
+		if (neighbor->heap_index == -1)
 			push_open_node(neighbor);
+		else
+			update_open_node(neighbor);
 	}
 	return true;
 }/* Do A* search of tiles to create a path from `start' to `goal'.
@@ -102,8 +103,7 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
  * Returns true if a path is created
  */bool AStarPath::path_search(MapCoord &start, MapCoord &goal) {
 	//DEBUG(0,LEVEL_DEBUGGING,"SEARCH: %d: %d,%d -> %d,%d\n",actor->get_actor_num(),start.x,start.y,goal.x,goal.y);
-	astar_node *start_node = new astar_node;
-	start_node->loc = start;
+	astar_node *start_node = new_node(start);
 	start_node->to_start = 0;
 	start_node->to_goal = path_cost_est(start, goal);
 	start_node->score = start_node->to_start + start_node->to_goal;
@@ -112,7 +112,7 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 	const uint32 max_score = get_max_score(start_node->to_goal);
 	const uint32 max_steps = 8 * 2 * 4; // walk up to four screen lengths before searching again
 	while (!open_nodes.empty()) {
-		astar_node *nnode = pop_open_node(); // next closest
+		astar_node *nnode = pop_open_node(); // next closest, now closed
 		if (nnode->loc == goal || nnode->len >= max_steps) {
 			if (nnode->loc != goal)
 				DEBUG(0, LEVEL_DEBUGGING, "out of steps, making partial path (nnode->len=%d)\n", nnode->len);
@@ -124,8 +124,6 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 		}
 		// check cardinal neighbors (starting at top going clockwise)
 		search_node_neighbors(nnode, goal, max_score);
-		// node and neighbors checked, put into closed
-		closed_nodes.push_back(nnode);
 	}
 //DEBUG(0,LEVEL_DEBUGGING,"FAIL\n");
 	delete_nodes();
@@ -138,64 +136,98 @@ sint32 AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
 	        || c2.distance(c1) > 1)
 		return (-1);
 	return (1);
-}/* Return an item in the list of closed nodes whose location matches `ncmp'.
- */astar_node *AStarPath::find_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc)
-			return (*n);
-	return (NULL);
-}/* Return an item in the list of closed nodes whose location matches `ncmp'.
- */astar_node *AStarPath::find_open_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = open_nodes.begin(); n != open_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc)
-			return (*n);
-	return (NULL);
-}/* Add new node pointer to the list of open nodes (sorting by score).
- */void AStarPath::push_open_node(astar_node *node) {
-	Std::list<astar_node *>::iterator n, next;
-	if (open_nodes.empty()) {
-		open_nodes.push_front(node);
-		return;
+}
+
+/* Return a cleared node at location `loc', reusing a free one if possible,
+ * and add it to the seen nodes.
+ */
+astar_node *AStarPath::new_node(const MapCoord &loc) {
+	astar_node *node;
+	if (free_nodes.empty()) {
+		node = new astar_node;
+	} else {
+		node = free_nodes.back();
+		free_nodes.pop_back();
+		*node = astar_node();
 	}
-	n = open_nodes.begin();
-	// get to end of list or to a node with equal or greater score
-	while (n != open_nodes.end() && (*n++)->score < node->score);
-	open_nodes.insert(n, node); // and add before that location
-}/* Return pointer to the highest priority node from the list of open nodes, and
+	node->loc = loc;
+	seen_nodes[node_key(loc)] = node;
+	return (node);
+}
+
+/* Return the open or closed node whose location matches `loc'.
+ */
+astar_node *AStarPath::find_node(const MapCoord &loc) {
+	Common::HashMap<uint32, astar_node *>::iterator n = seen_nodes.find(node_key(loc));
+	if (n != seen_nodes.end())
+		return (n->_value);
+	return (NULL);
+}
+
+/* Add node to the open nodes.
+ */
+void AStarPath::push_open_node(astar_node *node) {
+	open_nodes.push_back(node);
+	heap_set(open_nodes.size() - 1, node);
+	heap_up(open_nodes.size() - 1);
+}
+
+/* Return pointer to the highest priority node from the list of open nodes, and
  * remove it.
- */astar_node *AStarPath::pop_open_node() {
+ */
+astar_node *AStarPath::pop_open_node() {
 	astar_node *best = open_nodes.front();
-	open_nodes.pop_front(); // remove it
+	astar_node *last = open_nodes.back();
+	open_nodes.pop_back();
+	if (!open_nodes.empty()) {
+		heap_set(0, last);
+		heap_down(0);
+	}
+	best->heap_index = -1;
 	return (best);
 }
 
-/* Find item in the list of closed nodes whose location matched `ncmp', and
- * remove it from the list.
+/* Move an open node whose score was lowered to its new place.
  */
-void AStarPath::remove_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc) {
-			closed_nodes.erase(n);
-			return;
-		}
+void AStarPath::update_open_node(astar_node *node) {
+	heap_up(node->heap_index);
 }
 
-/* Delete nodes dereferenced from pointers in the lists.
- */
-void AStarPath::delete_nodes() {
-	while (!open_nodes.empty()) {
-		astar_node *delnode = open_nodes.front();
-		open_nodes.pop_front();
-		delete delnode;
+void AStarPath::heap_up(uint32 i) {
+	astar_node *node = open_nodes[i];
+	while (i > 0) {
+		uint32 parent = (i - 1) / 2;
+		if (!node_less(node, open_nodes[parent]))
+			break;
+		heap_set(i, open_nodes[parent]);
+		i = parent;
 	}
-	while (!closed_nodes.empty()) {
-		astar_node *delnode = closed_nodes.front();
-		closed_nodes.pop_front();
-		delete delnode;
+	heap_set(i, node);
+}
+
+void AStarPath::heap_down(uint32 i) {
+	astar_node *node = open_nodes[i];
+	const uint32 count = open_nodes.size();
+	while (2 * i + 1 < count) {
+		uint32 child = 2 * i + 1;
+		if (child + 1 < count && node_less(open_nodes[child + 1], open_nodes[child]))
+			child++;
+		if (!node_less(open_nodes[child], node))
+			break;
+		heap_set(i, open_nodes[child]);
+		i = child;
 	}
+	heap_set(i, node);
+}
+
+/* Clear the open and closed nodes, keeping them for the next search.
+ */
+void AStarPath::delete_nodes() {
+	Common::HashMap<uint32, astar_node *>::iterator n;
+	for (n = seen_nodes.begin(); n != seen_nodes.end(); n++)
+		free_nodes.push_back(n->_value);
+	seen_nodes.clear();
+	open_nodes.resize(0);
 }
 
 } // End of namespace Nuvie
@@ -23,6 +23,7 @@
 #ifndef NUVIE_PATHFINDER_ASTAR_PATH_H
 #define NUVIE_PATHFINDER_ASTAR_PATH_H
 
+#include "ultima/shared/std/containers.h"
 #include "ultima/nuvie/core/map.h"
 #include "ultima/nuvie/pathfinder/path.h"
 
@@ -36,26 +37,26 @@ typedef struct astar_node_s {
 	uint32 score; // node score
 	uint32 len; // number of nodes before this one, regardless of score
 	struct astar_node_s *parent;
+	sint32 heap_index; // position in the open nodes, or -1 if closed
 	astar_node_s() : loc(0, 0, 0), to_start(0), to_goal(0), score(0), len(0),
-		parent(NULL) { }
+		parent(NULL), heap_index(-1) { }
 } astar_node;
 /* Provides A* search and cost methods for PathFinder and subclasses.
  */class AStarPath: public Path {
 protected:
-	Std::list<astar_node *> open_nodes, closed_nodes; // nodes seen
+	Std::vector<astar_node *> open_nodes; // nodes to check, as a binary heap by score
+	Common::HashMap<uint32, astar_node *> seen_nodes; // open and closed nodes, by location
+	Std::vector<astar_node *> free_nodes; // allocated nodes, reused by later searches
 	astar_node *final_node; // last node in path search, used by create_path()
 	/* Forms a usable path from results of a search. */
 	void create_path();
 	/* Search routine. */
 	bool search_node_neighbors(astar_node *nnode, MapCoord &goal, const uint32 max_score);
-	bool compare_neighbors(astar_node *nnode, astar_node *neighbor,
-	                       sint32 nnode_to_neighbor, astar_node *in_open,
-	                       astar_node *in_closed);
-	bool score_to_neighbor(sint8 dir, astar_node *nnode, astar_node *neighbor,
+	bool score_to_neighbor(sint8 dir, astar_node *nnode, MapCoord &neighbor_loc,
 	                       sint32 &nnode_to_neighbor);
 public:
 	AStarPath();
-	~AStarPath() override { }
+	~AStarPath() override;
 	bool path_search(MapCoord &start, MapCoord &goal) override;
 	uint32 path_cost_est(MapCoord &s, MapCoord &g) override  {
 		return (Path::path_cost_est(s, g));
@@ -68,13 +69,23 @@ public:
 	}
 	sint32 step_cost(MapCoord &c1, MapCoord &c2) override;
 protected:
-	/* FIXME: These node functions can be replaced with a priority_queue and a list. */
-	astar_node *find_open_node(astar_node *ncmp);
+	astar_node *new_node(const MapCoord &loc);
+	astar_node *find_node(const MapCoord &loc);
 	void push_open_node(astar_node *node);
 	astar_node *pop_open_node();
-	astar_node *find_closed_node(astar_node *ncmp);
-	void remove_closed_node(astar_node *ncmp);
+	void update_open_node(astar_node *node);
 	void delete_nodes();
+private:
+	bool node_less(const astar_node *n1, const astar_node *n2) const {
+		return (n1->score < n2->score
+		        || (n1->score == n2->score && n1->to_goal < n2->to_goal));
+	}
+	void heap_set(uint32 i, astar_node *node) {
+		open_nodes[i] = node;
+		node->heap_index = i;
+	}
+	void heap_up(uint32 i);
+	void heap_down(uint32 i);
 };
 
 } // End of namespace Nuvie
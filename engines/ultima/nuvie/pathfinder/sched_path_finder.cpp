@@ -29,6 +29,12 @@
 namespace Ultima {
 namespace Nuvie {
 
+static const uint32 SCHED_SEARCH_SLICE_MS = 50;
+static const uint32 SCHED_SEARCHES_PER_SLICE = 4;
+
+uint32 SchedPathFinder::search_slice_start = 0;
+uint32 SchedPathFinder::searches_in_slice = 0;
+
 /* NOTE: Path_type must always be valid. */
 SchedPathFinder::SchedPathFinder(Actor *a, MapCoord g, Path *path_type)
 	: ActorPathFinder(a, g), prev_step_i(0), next_step_i(0) {
@@ -58,6 +64,8 @@ bool SchedPathFinder::get_next_move(MapCoord &step) {
 }
 
 bool SchedPathFinder::find_path() {
+	if (!reserve_search())
+		return false; // too many searches right now, keep the old path
 	if (search->have_path())
 		search->delete_path();
 	if (!search->path_search(loc, goal)) {
@@ -69,6 +77,19 @@ bool SchedPathFinder::find_path() {
 	return true;
 }
 
+/* Returns true if a new search can be started in the current time slice. */
+bool SchedPathFinder::reserve_search() {
+	uint32 now = SDL_GetTicks();
+	if (now - search_slice_start >= SCHED_SEARCH_SLICE_MS) {
+		search_slice_start = now;
+		searches_in_slice = 0;
+	}
+	if (searches_in_slice >= SCHED_SEARCHES_PER_SLICE)
+		return false;
+	++searches_in_slice;
+	return true;
+}
+
 /* Returns true if actor location is correct. */
 bool SchedPathFinder::is_location_in_path() {
 	MapCoord prev_step = search->get_step(prev_step_i);
@@ -34,6 +34,11 @@ class SchedPathFinder: public ActorPathFinder {
 protected:
 	uint32 prev_step_i, next_step_i; /* step counters */
 
+	/* Searches are expensive, so only a few are started in each time slice.
+	   Actors that miss out wait in place and try again on a later update. */
+	static uint32 search_slice_start;
+	static uint32 searches_in_slice;
+
 public:
 	/* Pass 'path_type' to define search rules and methods to be used. The
 	   PathFinder is responsible for deleting it when finished. */
@@ -46,6 +51,7 @@ public:
 
 	bool check_loc(const MapCoord &loc) override; // ignores other actors
 protected:
+	bool reserve_search();
 	bool is_location_in_path();
 	void incr_step();
 };
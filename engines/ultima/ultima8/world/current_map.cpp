@@ -44,7 +44,7 @@
 namespace Ultima {
 namespace Ultima8 {
 
-typedef Std::list<Item *> item_list;
+typedef CurrentMap::ItemList item_list;
 
 static const int INT_MAX_VALUE = 0x7fffffff;
 
@@ -158,7 +158,7 @@ void CurrentMap::writeback() {
 }
 
 void CurrentMap::loadItems(const Std::list<Item *> &itemlist, bool callCacheIn) {
-	item_list::const_iterator iter;
+	Std::list<Item *>::const_iterator iter;
 	for (iter = itemlist.begin(); iter != itemlist.end(); ++iter) {
 		Item *item = *iter;
 
@@ -251,7 +251,7 @@ void CurrentMap::addItem(Item *item) {
 	}
 #endif
 
-	_items[cx][cy].push_front(item);
+	_items[cx][cy].insert_at(0, item);
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -405,7 +405,10 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 	int32 cx = oldx / _mapChunkSize;
 	int32 cy = oldy / _mapChunkSize;
 
-	_items[cx][cy].remove(item);
+	item_list &items = _items[cx][cy];
+	item_list::iterator iter = Common::find(items.begin(), items.end(), item);
+	if (iter != items.end())
+		items.erase(iter);
 	item->clearExtFlag(Item::EXT_INCURMAP);
 }
 
@@ -518,9 +521,13 @@ void CurrentMap::updateFastArea(int32 from_x, int32 from_y, int32 from_z, int32
 void CurrentMap::setChunkFast(int32 cx, int32 cy) {
 	_fast[cy][cx / 32] |= 1 << (cx & 31);
 
-	item_list::iterator iter;
-	for (iter = _items[cx][cy].begin();
-	        iter != _items[cx][cy].end(); ++iter) {
+	// Work on a copy, as entering the fast area can move items around
+	const item_list items = _items[cx][cy];
+	item_list::const_iterator iter;
+	for (iter = items.begin(); iter != items.end(); ++iter) {
+		// Skip the items moved out of the chunk, or destroyed, meanwhile
+		if (!isInChunk(*iter, cx, cy))
+			continue;
 		(*iter)->enterFastArea();
 	}
 }
@@ -528,10 +535,15 @@ void CurrentMap::setChunkFast(int32 cx, int32 cy) {
 void CurrentMap::unsetChunkFast(int32 cx, int32 cy) {
 	_fast[cy][cx / 32] &= ~(1 << (cx & 31));
 
-	item_list::iterator iter = _items[cx][cy].begin();
-	while (iter != _items[cx][cy].end()) {
+	// Work on a copy, as leaving the fast area can remove items
+	const item_list items = _items[cx][cy];
+	item_list::const_iterator iter = items.begin();
+	while (iter != items.end()) {
 		Item *item = *iter;
 		++iter;
+		// Skip the items moved out of the chunk, or destroyed, meanwhile
+		if (!isInChunk(item, cx, cy))
+			continue;
 #if VALIDATE_CHUNKS
 		int32 x, y, z;
 		item->getLocation(x, y, z);
@@ -544,6 +556,12 @@ void CurrentMap::unsetChunkFast(int32 cx, int32 cy) {
 	}
 }
 
+bool CurrentMap::isInChunk(const Item *item, int32 cx, int32 cy) const {
+	// Only compare the pointers, the item may have been deleted
+	const item_list &items = _items[cx][cy];
+	return Common::find(items.begin(), items.end(), item) != items.end();
+}
+
 inline void CurrentMap::clipMapChunks(int &minx, int &maxx, int &miny, int &maxy) {
 	minx = CLIP(minx, 0, MAP_NUM_CHUNKS - 1);
 	maxx = CLIP(maxx, 0, MAP_NUM_CHUNKS - 1);
@@ -724,7 +742,7 @@ TeleportEgg *CurrentMap::findDestination(uint16 id) {
 	return nullptr;
 }
 
-const Std::list<Item *> *CurrentMap::getItemList(int32 gx, int32 gy) const {
+const CurrentMap::ItemList *CurrentMap::getItemList(int32 gx, int32 gy) const {
 	if (gx < 0 || gy < 0 || gx >= MAP_NUM_CHUNKS || gy >= MAP_NUM_CHUNKS)
 		return nullptr;
 	return &_items[gx][gy];
@@ -42,6 +42,10 @@ class EggHatcherProcess;
 class CurrentMap {
 	friend class World;
 public:
+	//! Items of a map chunk. Stored contiguously, since the chunks are
+	//! scanned far more often than items are added or removed.
+	typedef Std::vector<Item *> ItemList;
+
 	CurrentMap();
 	~CurrentMap();
 
@@ -195,7 +199,7 @@ public:
 	TeleportEgg *findDestination(uint16 id);
 
 	// Not allowed to modify the list. Remember to use const_iterator
-	const Std::list<Item *> *getItemList(int32 gx, int32 gy) const;
+	const ItemList *getItemList(int32 gx, int32 gy) const;
 
 	bool isChunkFast(int32 cx, int32 cy) const {
 		// CONSTANTS!
@@ -227,7 +231,7 @@ private:
 
 	// item lists. Lots of them :-)
 	// items[x][y]
-	Std::list<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+	ItemList _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
 
 	ProcId _eggHatcher;
 
@@ -243,6 +247,9 @@ private:
 
 	void setChunkFast(int32 cx, int32 cy);
 	void unsetChunkFast(int32 cx, int32 cy);
+
+	//! Check if the item is still in the item list of the given chunk
+	bool isInChunk(const Item *item, int32 cx, int32 cy) const;
 };
 
 } // End of namespace Ultima8
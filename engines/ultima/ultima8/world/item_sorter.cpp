@@ -50,7 +50,8 @@ struct SortItem {
 			_syTop(0), _sxBot(0), _syBot(0),_f32x32(false), _flat(false),
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
-			_land(false), _occluded(false), _clipped(false), _sprite(false) { }
+			_land(false), _occluded(false), _clipped(false), _sprite(false),
+			_addIndex(0), _candidateOf(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -115,6 +116,9 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	uint32  _addIndex;    // Order in which the item was added to the display list
+	uint32  _candidateOf; // _addIndex of the last item this was gathered for comparison with
+
 	// Note that Std::priority_queue could be used here, BUT there is no guarentee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Std::list, BUT there is no guarentee that it will keep wont delete
@@ -235,6 +239,16 @@ struct SortItem {
 		return _z < other->_z || (_z == other->_z && _flat && !other->_flat);
 	}
 
+	// Comparison giving the order of the items in the display list, which
+	// is sorted by ListLessThan, and then by the order the items were added
+	static bool ListOrder(const SortItem *si1, const SortItem *si2) {
+		if (si1->ListLessThan(si2))
+			return true;
+		if (si2->ListLessThan(si1))
+			return false;
+		return si1->_addIndex < si2->_addIndex;
+	}
+
 };
 
 inline bool SortItem::overlap(const SortItem &si2) const {
@@ -431,7 +445,8 @@ ConsoleStream &operator<<(ConsoleStream &cs, const SortItem &si) {
 
 ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
+	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0),
+	_addCounter(0), _itemCount(0), _compareCount(0) {
 	int i = 2048;
 	while (i--) _itemsUnused = new SortItem(_itemsUnused);
 }
@@ -470,6 +485,12 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	// Set the RenderSurface, and reset the item list
 	_surf = rs;
 	_orderCounter = 0;
+	_itemCount = 0;
+	_compareCount = 0;
+
+	for (int i = 0; i < SORT_COLUMNS; i++)
+		_columns[i].resize(0);
+	_keyTails.resize(0);
 
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	_camSx = (camx - camy) / 4;
@@ -563,14 +584,32 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	si->_addIndex = ++_addCounter;
+	_itemCount++;
+
+	// Items which don't overlap in screenspace x can't overlap at all, so
+	// only the items sharing a column with us need to be compared. They are
+	// compared in display list order, as the results depend on it.
+	const int colStart = CLIP<int>((si->_sxLeft >> SORT_COLUMN_SHIFT) + SORT_COLUMNS / 2, 0, SORT_COLUMNS - 1);
+	const int colEnd = CLIP<int>((si->_sxRight >> SORT_COLUMN_SHIFT) + SORT_COLUMNS / 2, 0, SORT_COLUMNS - 1);
+
+	_candidates.resize(0);
+	for (int col = colStart; col <= colEnd; col++) {
+		Common::Array<SortItem *>::const_iterator it;
+		for (it = _columns[col].begin(); it != _columns[col].end(); ++it) {
+			if ((*it)->_candidateOf != si->_addIndex) {
+				(*it)->_candidateOf = si->_addIndex;
+				_candidates.push_back(*it);
+			}
+		}
+	}
+	Common::sort(_candidates.begin(), _candidates.end(), SortItem::ListOrder);
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->ListLessThan(si2))
-			addpoint = si2;
+	// Iterate the list and compare _shapes
+	Common::Array<SortItem *>::const_iterator it;
+	for (it = _candidates.begin(); it != _candidates.end(); ++it) {
+		SortItem *si2 = *it;
+		_compareCount++;
 
 		// Doesn't overlap
 		if (si2->_occluded || !si->overlap(*si2))
@@ -599,28 +638,49 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
+	InsertSortItem(si);
 
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
+	// Occluded items are skipped by all the following comparisons
+	if (!si->_occluded) {
+		for (int col = colStart; col <= colEnd; col++)
+			_columns[col].push_back(si);
+	}
+}
+
+void ItemSorter::InsertSortItem(SortItem *si) {
+	// The list is sorted by ListLessThan, and items with the same key stay
+	// in the order they were added. So the item goes right after the last
+	// item with a key lower than or equal to its own.
+	uint lo = 0, hi = _keyTails.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (si->ListLessThan(_keyTails[mid]))
+			hi = mid;
 		else
-			_items = si;
+			lo = mid + 1;
 	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
+
+	SortItem *after = nullptr;
+	if (lo > 0 && !_keyTails[lo - 1]->ListLessThan(si)) {
+		// Same key, we are the new last item for it
+		after = _keyTails[lo - 1];
+		_keyTails[lo - 1] = si;
+	} else {
+		if (lo > 0)
+			after = _keyTails[lo - 1];
+		_keyTails.insert_at(lo, si);
 	}
+
+	si->_prev = after;
+	si->_next = after ? after->_next : _items;
+	if (si->_next)
+		si->_next->_prev = si;
+	else
+		_itemsTail = si;
+	if (after)
+		after->_next = si;
+	else
+		_items = si;
 }
 
 void ItemSorter::AddItem(const Item *add) {
@@ -633,6 +693,8 @@ void ItemSorter::AddItem(const Item *add) {
 SortItem *_prev = 0;
 
 void ItemSorter::PaintDisplayList(bool item_highlight) {
+	debug(10, "ItemSorter: %u items, %u comparisons", _itemCount, _compareCount);
+
 	_prev = nullptr;
 	SortItem *it = _items;
 	SortItem *end = nullptr;
@@ -23,6 +23,8 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -44,6 +46,23 @@ class ItemSorter {
 
 	int32       _camSx, _camSy;
 
+	// Items of the display list, bucketed by the screenspace columns they
+	// cover, so added items are only compared to the items they can overlap
+	enum { SORT_COLUMNS = 64, SORT_COLUMN_SHIFT = 6 };
+	Common::Array<SortItem *> _columns[SORT_COLUMNS];
+
+	// Last item of each distinct sort key in the display list, in list order
+	Common::Array<SortItem *> _keyTails;
+
+	// Scratch list of the items a new item has to be compared to
+	Common::Array<SortItem *> _candidates;
+
+	uint32      _addCounter;
+
+	// Items added and pairs of items compared for the current display list
+	uint32      _itemCount;
+	uint32      _compareCount;
+
 public:
 	ItemSorter();
 	~ItemSorter();
@@ -68,6 +87,7 @@ public:
 	void IncSortLimit(int count);
 
 private:
+	void InsertSortItem(SortItem *);
 	bool PaintSortItem(SortItem *);
 	bool NullPaintSortItem(SortItem *);
 };
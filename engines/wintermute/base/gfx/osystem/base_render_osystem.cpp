@@ -40,6 +40,10 @@
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+// Separate dirty rects are merged if the area covering both isn't larger than this factor of their combined areas
+#define DIRTY_RECT_MERGE_OVERDRAW 1.25f
+// Above this many dirty rects, they are all merged into one
+#define DIRTY_RECT_MAX_COUNT 16
 
 namespace Wintermute {
 
@@ -57,7 +61,7 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
+	_lastFrameTicketsValid = false;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -75,8 +79,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -160,10 +162,11 @@ bool BaseRenderOSystem::forcedFlip() {
 }
 
 bool BaseRenderOSystem::flip() {
+	_lastFrameTicketsValid = false;
+
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -202,9 +205,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -306,22 +307,10 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		RenderQueueIterator it;
+		if (findLastFrameTicket(compare, it)) {
+			drawFromQueuedTicket(it);
+			return;
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
@@ -385,13 +374,82 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 	}
 }
 
+static uint32 hashTicket(const RenderTicket &ticket) {
+	const Common::Rect *srcRect = ticket.getSrcRect();
+	uint32 hash = (uint32)(size_t)ticket._owner;
+	hash = hash * 31 + (uint16)ticket._dstRect.left;
+	hash = hash * 31 + (uint16)ticket._dstRect.top;
+	hash = hash * 31 + (uint16)ticket._dstRect.right;
+	hash = hash * 31 + (uint16)ticket._dstRect.bottom;
+	hash = hash * 31 + (uint16)srcRect->left;
+	hash = hash * 31 + (uint16)srcRect->top;
+	hash = hash * 31 + (uint16)srcRect->right;
+	hash = hash * 31 + (uint16)srcRect->bottom;
+	return hash;
+}
+
+bool BaseRenderOSystem::findLastFrameTicket(const RenderTicket &compare, RenderQueueIterator &ticket) {
+	// The tickets after _lastFrameIter are the ones from last frame that weren't
+	// requested yet, in the order they were drawn. Index them once per frame.
+	if (!_lastFrameTicketsValid) {
+		_lastFrameTickets.clear();
+		RenderQueueIterator it = _lastFrameIter;
+		++it;
+		for (; it != _renderQueue.end(); ++it) {
+			_lastFrameTickets[hashTicket(**it)].push_back(it);
+		}
+		_lastFrameTicketsValid = true;
+	}
+
+	TicketIndex::iterator bucket = _lastFrameTickets.find(hashTicket(compare));
+	if (bucket == _lastFrameTickets.end()) {
+		return false;
+	}
+
+	Common::Array<RenderQueueIterator> &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); ++i) {
+		RenderTicket *compareTicket = *tickets[i];
+		if (*(compareTicket) == compare && compareTicket->_isValid) {
+			ticket = tickets[i];
+			tickets.remove_at(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+static int rectArea(const Common::Rect &rect) {
+	return rect.width() * rect.height();
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect dirtyRect(rect);
+	dirtyRect.clip(_renderRect);
+	if (dirtyRect.isEmpty()) {
+		return;
 	}
-	_dirtyRect->clip(_renderRect);
+
+	uint i = 0;
+	while (i < _dirtyRects.size()) {
+		Common::Rect merged(_dirtyRects[i]);
+		merged.extend(dirtyRect);
+		if (rectArea(merged) <= (rectArea(_dirtyRects[i]) + rectArea(dirtyRect)) * DIRTY_RECT_MERGE_OVERDRAW) {
+			// The merged rect may now be worth merging with rects already checked
+			_dirtyRects.remove_at(i);
+			dirtyRect = merged;
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	if (_dirtyRects.size() >= DIRTY_RECT_MAX_COUNT) {
+		for (i = 0; i < _dirtyRects.size(); ++i) {
+			dirtyRect.extend(_dirtyRects[i]);
+		}
+		_dirtyRects.clear();
+	}
+	_dirtyRects.push_back(dirtyRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -410,7 +468,7 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -420,43 +478,46 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+	bool singleOpaqueTicket = !_renderQueue.empty() && _renderQueue.front() == _renderQueue.back() && _renderQueue.front()->_transform._alphaDisable == true;
+
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyRect = _dirtyRects[i];
+
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+		if (!singleOpaqueTicket || dirtyRect != _renderQueue.front()->_dstRect) {
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(dirtyRect, _clearColor);
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
-	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+
+		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+			RenderTicket *ticket = *it;
+			if (ticket->_dstRect.intersects(dirtyRect)) {
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(dirtyRect);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				_needsFlip = true;
+			}
 		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
-		ticket->_wantsDraw = false;
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
+	}
+
+	// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		(*it)->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -596,6 +657,7 @@ void BaseRenderOSystem::endSaveLoad() {
 	// so just skip this single frame.
 	_skipThisFrame = true;
 	_lastFrameIter = _renderQueue.end();
+	_lastFrameTicketsValid = false;
 
 	_renderSurface->fillRect(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
 	g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
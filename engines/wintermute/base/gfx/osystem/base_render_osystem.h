@@ -33,6 +33,8 @@
 #include "common/rect.h"
 #include "graphics/surface.h"
 #include "common/list.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "graphics/transform_struct.h"
 
 namespace Wintermute {
@@ -118,9 +120,19 @@ public:
 private:
 	/**
 	 * Mark a specified rect of the screen as dirty.
+	 * Dirty rects are merged when redrawing the area covering both of them
+	 * isn't much larger than redrawing them separately.
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Find the first ticket from last frame, not yet requested this frame,
+	 * that is equal to a new draw call.
+	 * @param compare the ticket to compare against.
+	 * @param ticket set to the position of the found ticket in the queue.
+	 * @return true if a matching ticket was found.
+	 */
+	bool findLastFrameTicket(const RenderTicket &compare, RenderQueueIterator &ticket);
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
@@ -129,9 +141,15 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
 
+	// Tickets from last frame not yet requested this frame, by hash of
+	// their draw arguments, in queue order. Built on the first draw of a frame.
+	typedef Common::HashMap<uint32, Common::Array<RenderQueueIterator> > TicketIndex;
+	TicketIndex _lastFrameTickets;
+	bool _lastFrameTicketsValid;
+
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
 	Common::Rect _renderRect;
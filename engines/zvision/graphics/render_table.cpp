@@ -31,10 +31,17 @@ namespace ZVision {
 RenderTable::RenderTable(uint numColumns, uint numRows)
 	: _numRows(numRows),
 	  _numColumns(numColumns),
-	  _renderState(FLAT) {
+	  _renderState(FLAT),
+	  _bilinear(false) {
 	assert(numRows != 0 && numColumns != 0);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+	_sourceIndex = new uint32[numRows * numColumns];
+	_sourceFraction = new byte[numRows * numColumns * 2];
+
+	for (uint32 i = 0; i < numRows * numColumns; i++)
+		_sourceIndex[i] = i;
+	memset(_sourceFraction, 0, numRows * numColumns * 2);
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -42,6 +49,8 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 
 RenderTable::~RenderTable() {
 	delete[] _internalBuffer;
+	delete[] _sourceIndex;
+	delete[] _sourceFraction;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -85,45 +94,63 @@ const Common::Point RenderTable::convertWarpedCoordToFlatCoord(const Common::Poi
 }
 
 void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect) {
-	uint32 destOffset = 0;
-
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+		const uint32 *sourceIndex = _sourceIndex + y * _numColumns + subRect.left;
+		uint16 *dest = destBuffer;
 
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-		}
+		for (int16 x = subRect.left; x < subRect.right; ++x)
+			*dest++ = sourceBuffer[*sourceIndex++];
 
-		destOffset += destWidth;
+		destBuffer += destWidth;
 	}
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
-
 	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
 	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+	const Common::Rect rect(srcBuf->w, srcBuf->h);
+
+	if (_bilinear)
+		mutateImageBilinear(sourceBuffer, destBuffer, srcBuf->w, rect, srcBuf->format);
+	else
+		mutateImage(sourceBuffer, destBuffer, srcBuf->w, rect);
+}
+
+void RenderTable::mutateImageBilinear(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect, const Graphics::PixelFormat &format) {
+	// Spread the pixels over 32 bits, with the green component in the upper
+	// half, so that each component has room to be multiplied by a weight
+	const uint32 redBlueMask = ((0xFF >> format.rLoss) << format.rShift) | ((0xFF >> format.bLoss) << format.bShift);
+	const uint32 greenMask = (0xFF >> format.gLoss) << format.gShift;
+	const uint32 mask = redBlueMask | (greenMask << 16);
+
+	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
+		const uint32 index = y * _numColumns + subRect.left;
+		const uint32 *sourceIndex = _sourceIndex + index;
+		const byte *sourceFraction = _sourceFraction + index * 2;
+		uint16 *dest = destBuffer;
+
+		for (int16 x = subRect.left; x < subRect.right; ++x) {
+			const uint16 *source = sourceBuffer + *sourceIndex++;
+			const uint32 fx = *sourceFraction++;
+			const uint32 fy = *sourceFraction++;
 
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+			// Fractions are only set when the next pixel exists
+			const uint32 nextX = fx ? 1 : 0;
+			const uint32 nextY = fy ? _numColumns : 0;
 
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+			const uint32 p00 = (source[0] | ((uint32)source[0] << 16)) & mask;
+			const uint32 p01 = (source[nextX] | ((uint32)source[nextX] << 16)) & mask;
+			const uint32 p10 = (source[nextY] | ((uint32)source[nextY] << 16)) & mask;
+			const uint32 p11 = (source[nextY + nextX] | ((uint32)source[nextY + nextX] << 16)) & mask;
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+			const uint32 top = ((p00 * (32 - fx) + p01 * fx) >> 5) & mask;
+			const uint32 bottom = ((p10 * (32 - fx) + p11 * fx) >> 5) & mask;
+			const uint32 result = ((top * (32 - fy) + bottom * fy) >> 5) & mask;
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
+			*dest++ = (uint16)(result | (result >> 16));
 		}
+
+		destBuffer += destWidth;
 	}
 }
 
@@ -165,20 +192,16 @@ void RenderTable::generatePanoramaLookupTable() {
 
 		// To get x in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _panoramaOptions.linearScale
-		int32 xInCylinderCoords = int32(floor((cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth));
+		float xInCylinderCoords = (cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth;
 
 		float cosAlpha = cos(alpha);
 
 		for (uint y = 0; y < _numRows; ++y) {
 			// To calculate y in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 yInCylinderCoords = int32(floor(halfHeight + ((float)y - halfHeight) * cosAlpha));
-
-			uint32 index = y * _numColumns + x;
+			float yInCylinderCoords = halfHeight + ((float)y - halfHeight) * cosAlpha;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSourcePosition(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
@@ -199,25 +222,37 @@ void RenderTable::generateTiltLookupTable() {
 
 		// To get y in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _tiltOptions.linearScale
-		int32 yInCylinderCoords = int32(floor((cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight));
+		float yInCylinderCoords = (cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight;
 
 		float cosAlpha = cos(alpha);
-		uint32 columnIndex = y * _numColumns;
 
 		for (uint x = 0; x < _numColumns; ++x) {
 			// To calculate x in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 xInCylinderCoords = int32(floor(halfWidth + ((float)x - halfWidth) * cosAlpha));
+			float xInCylinderCoords = halfWidth + ((float)x - halfWidth) * cosAlpha;
 
-			uint32 index = columnIndex + x;
-
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSourcePosition(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
 
+void RenderTable::setSourcePosition(uint x, uint y, float sourceX, float sourceY) {
+	const int32 flatX = int32(floor(sourceX));
+	const int32 flatY = int32(floor(sourceY));
+	const uint32 index = y * _numColumns + x;
+
+	// Only store the (x,y) offsets instead of the absolute positions
+	_internalBuffer[index].x = flatX - x;
+	_internalBuffer[index].y = flatY - y;
+
+	_sourceIndex[index] = flatY * _numColumns + flatX;
+
+	// Leave out the neighbours past the edges of the image
+	byte *fraction = _sourceFraction + index * 2;
+	fraction[0] = (flatX + 1 < (int32)_numColumns) ? (byte)((sourceX - flatX) * 32.0f) & 31 : 0;
+	fraction[1] = (flatY + 1 < (int32)_numRows) ? (byte)((sourceY - flatY) * 32.0f) & 31 : 0;
+}
+
 void RenderTable::setPanoramaFoV(float fov) {
 	assert(fov > 0.0f);
 
@@ -45,6 +45,14 @@ private:
 	Common::Point *_internalBuffer;
 	RenderState _renderState;
 
+	// Absolute source pixel index of each destination pixel, so that
+	// warping an image is a plain table lookup per pixel
+	uint32 *_sourceIndex;
+	// Horizontal and vertical fractions of each source position, in 1/32th
+	// of a pixel, for bilinear filtering
+	byte *_sourceFraction;
+	bool _bilinear;
+
 	struct {
 		float fieldOfView;
 		float linearScale;
@@ -66,6 +74,9 @@ public:
 	}
 	void setRenderState(RenderState newState);
 
+	void setBilinear(bool bilinear) { _bilinear = bilinear; }
+	bool isBilinear() const { return _bilinear; }
+
 	const Common::Point convertWarpedCoordToFlatCoord(const Common::Point &point);
 
 	void mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect);
@@ -90,6 +101,9 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+	void setSourcePosition(uint x, uint y, float sourceX, float sourceY);
+
+	void mutateImageBilinear(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect, const Graphics::PixelFormat &format);
 };
 
 } // End of namespace ZVision
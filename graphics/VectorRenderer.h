@@ -292,6 +292,24 @@ public:
 	 */
 	virtual void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) = 0;
 
+	/**
+	 * The colors used by draw steps which don't set them themselves,
+	 * as left by the previous drawing operations.
+	 */
+	struct ColorState {
+		uint32 fg, bg, bevel, gradientStart, gradientEnd;
+
+		bool operator==(const ColorState &other) const {
+			return fg == other.fg && bg == other.bg && bevel == other.bevel &&
+				gradientStart == other.gradientStart && gradientEnd == other.gradientEnd;
+		}
+	};
+
+	/**
+	 * Returns the colors currently set, in the format of the active surface.
+	 */
+	virtual ColorState getColorState() const = 0;
+
 	/**
 	 * Sets the active drawing surface. All drawing from this
 	 * point on will be done on that surface.
@@ -478,6 +496,14 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Sets up the colors and options of the specified draw step without
+	 * drawing it, leaving the renderer in the same state as drawStep().
+	 *
+	 * @see drawStep
+	 */
+	void applyStepSettings(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
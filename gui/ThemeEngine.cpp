@@ -89,6 +89,14 @@ struct WidgetDrawData {
 
 	DrawLayer _layer;
 
+	/** Whether the rendered result of this item may be reused from the widget cache */
+	bool _cached;
+
+	/** Whether all the draw steps overwrite the item area with opaque pixels */
+	bool _opaque;
+
+	/** Whether one of the draw steps fills the whole surface */
+	bool _fillsSurface;
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -100,6 +108,181 @@ struct WidgetDrawData {
 	void calcBackgroundOffset();
 };
 
+/**
+ * Cache of already rendered DrawData items.
+ *
+ * An entry is identified by the item, its dynamic value, its size and its
+ * clipping, and drawing it again is replaced by a plain copy. Items made of
+ * draw steps which overwrite their whole area with opaque pixels, using only
+ * the colors they set, don't depend on anything else. For the others, like
+ * rounded or shadowed widgets, the entry is also identified by the colors left
+ * in the renderer, and keeps the pixels that were below the item. It is only
+ * used when they are unchanged.
+ */
+class WidgetCache {
+public:
+	struct Key {
+		DrawData type;
+		uint32 dynamic;
+		int16 width, height;
+		Common::Rect clip; ///< Clipping rectangle, relative to the item area
+		Graphics::VectorRenderer::ColorState colors; ///< Colors left by previous draws, for items which are not opaque
+
+		bool operator==(const Key &other) const {
+			return type == other.type && dynamic == other.dynamic &&
+				width == other.width && height == other.height && clip == other.clip &&
+				colors == other.colors;
+		}
+	};
+
+	static const uint kMaxCacheSize = 2 * 1024 * 1024;
+
+	WidgetCache() : _size(0) {}
+	~WidgetCache() { clear(); }
+
+	/**
+	 * Draw the cached rendering of an item.
+	 * @return true if the item was drawn from the cache
+	 */
+	bool draw(const Key &key, Graphics::ManagedSurface *surf, const Common::Rect &rect);
+
+	/**
+	 * Store the rendering of an item, which has just been drawn.
+	 * @param background  What was below the item before it was drawn, or
+	 *                    nullptr for opaque items.
+	 */
+	void store(const Key &key, Graphics::ManagedSurface *surf, const Common::Rect &rect,
+		const Graphics::ManagedSurface *background);
+
+	void clear();
+
+private:
+	struct Entry {
+		Key key;
+		Graphics::ManagedSurface surface;
+		Graphics::ManagedSurface background; ///< Empty for opaque items
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			uint hash = key.type;
+			hash = hash * 31 + key.dynamic;
+			hash = hash * 31 + (key.width << 16 | key.height);
+			hash = hash * 31 + (key.clip.left << 16 | (key.clip.top & 0xFFFF));
+			hash = hash * 31 + (key.clip.right << 16 | (key.clip.bottom & 0xFFFF));
+			hash = hash * 31 + key.colors.fg;
+			hash = hash * 31 + key.colors.bg;
+			return hash;
+		}
+	};
+
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, KeyHash> EntryMap;
+
+	static uint entrySize(const Entry *entry) {
+		return entry->surface.h * entry->surface.pitch + entry->background.h * entry->background.pitch;
+	}
+	static bool matchesBackground(const Entry *entry, Graphics::ManagedSurface *surf, const Common::Rect &rect);
+	void remove(EntryMap::iterator i);
+
+	EntryList _entries; ///< Entries in order of use, the most recently used first
+	EntryMap _map;
+	uint _size;
+};
+
+bool WidgetCache::draw(const Key &key, Graphics::ManagedSurface *surf, const Common::Rect &rect) {
+	EntryMap::iterator i = _map.find(key);
+	if (i == _map.end())
+		return false;
+
+	Entry *entry = *i->_value;
+	if (entry->surface.format != surf->format)
+		return false;
+
+	if (!entry->background.empty() && !matchesBackground(entry, surf, rect))
+		return false;
+
+	surf->copyRectToSurface(entry->surface, rect.left, rect.top, Common::Rect(rect.width(), rect.height()));
+
+	// Move the entry to the front of the list
+	_entries.erase(i->_value);
+	_entries.push_front(entry);
+	i->_value = _entries.begin();
+	return true;
+}
+
+bool WidgetCache::matchesBackground(const Entry *entry, Graphics::ManagedSurface *surf, const Common::Rect &rect) {
+	const uint rowSize = rect.width() * surf->format.bytesPerPixel;
+	for (int y = 0; y < rect.height(); y++) {
+		if (memcmp(entry->background.getBasePtr(0, y), surf->getBasePtr(rect.left, rect.top + y), rowSize))
+			return false;
+	}
+	return true;
+}
+
+void WidgetCache::store(const Key &key, Graphics::ManagedSurface *surf, const Common::Rect &rect,
+		const Graphics::ManagedSurface *background) {
+	EntryMap::iterator i = _map.find(key);
+	if (i != _map.end())
+		remove(i);
+
+	Entry *entry = new Entry;
+	entry->key = key;
+	entry->surface.create(rect.width(), rect.height(), surf->format);
+	entry->surface.copyRectToSurface(*surf, 0, 0, rect);
+	if (background)
+		entry->background.copyFrom(*background);
+
+	_entries.push_front(entry);
+	_map[key] = _entries.begin();
+	_size += entrySize(entry);
+
+	// Evict the least recently used entries
+	while (_size > kMaxCacheSize && _entries.size() > 1)
+		remove(_map.find(_entries.back()->key));
+}
+
+void WidgetCache::remove(EntryMap::iterator i) {
+	Entry *entry = *i->_value;
+	_size -= entrySize(entry);
+	_entries.erase(i->_value);
+	_map.erase(i);
+	delete entry;
+}
+
+void WidgetCache::clear() {
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		delete *i;
+	_entries.clear();
+	_map.clear();
+	_size = 0;
+}
+
+/**
+ * Check whether a draw step overwrites the whole item area with opaque pixels,
+ * using only the colors and options it sets itself.
+ */
+static bool isOpaqueDrawStep(const Graphics::DrawStep &step) {
+	if (step.drawingCall != &Graphics::VectorRenderer::drawCallback_SQUARE &&
+	    step.drawingCall != &Graphics::VectorRenderer::drawCallback_FILLSURFACE)
+		return false;
+
+	if (step.shadow || !step.autoWidth || !step.autoHeight ||
+	    step.padding != Common::Rect() || step.clip != Common::Rect())
+		return false;
+
+	switch (step.fillMode) {
+	case Graphics::VectorRenderer::kFillForeground:
+		return step.fgColor.set;
+	case Graphics::VectorRenderer::kFillBackground:
+		return step.bgColor.set && (step.fgColor.set || step.stroke == 0);
+	case Graphics::VectorRenderer::kFillGradient:
+		return step.gradColor1.set && step.gradColor2.set && (step.fgColor.set || step.stroke == 0);
+	default:
+		return false;
+	}
+}
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -187,7 +370,7 @@ static const DrawDataInfo kDrawDataDefaults[] = {
  * ThemeEngine class
  *********************************************************/
 ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
-	_system(nullptr), _vectorRenderer(nullptr),
+	_system(nullptr), _vectorRenderer(nullptr), _widgetCache(nullptr),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
 	_cursor(nullptr), _scaleFactor(1.0f) {
@@ -199,6 +382,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_parser = new ThemeParser(this);
 	_themeEval = new GUI::ThemeEval();
 	_themeEval->setScaleFactor(_scaleFactor);
+	_widgetCache = new WidgetCache();
 
 	_useCursor = false;
 
@@ -249,6 +433,9 @@ ThemeEngine::~ThemeEngine() {
 	unloadTheme();
 	unloadExtraFont();
 
+	delete _widgetCache;
+	_widgetCache = nullptr;
+
 	// Release all graphics surfaces
 	for (ImagesMap::iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
 		Graphics::ManagedSurface *surf = i->_value;
@@ -459,6 +646,9 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
 
+	// Cached renderings depend on the renderer and the surface format
+	_widgetCache->clear();
+
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
 	// list. Clearing it avoids invalid overlay writes when the backend
@@ -503,6 +693,13 @@ void ThemeEngine::addDrawStep(const Common::String &drawDataId, const Graphics::
 
 	assert(id != kDDNone && _widgets[id] != nullptr);
 	_widgets[id]->_steps.push_back(step);
+
+	// The rendering of items drawing over the background depends on it
+	if (!isOpaqueDrawStep(step))
+		_widgets[id]->_opaque = false;
+
+	if (step.drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE)
+		_widgets[id]->_fillsSurface = true;
 }
 
 bool ThemeEngine::addTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, TextAlignVertical alignV) {
@@ -777,6 +974,9 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_layer = kDrawDataDefaults[id].layer;
 	_widgets[id]->_textDataId = kTextDataNone;
+	_widgets[id]->_cached = cached;
+	_widgets[id]->_opaque = true;
+	_widgets[id]->_fillsSurface = false;
 
 	return true;
 }
@@ -819,6 +1019,7 @@ void ThemeEngine::unloadTheme() {
 		delete _widgets[i];
 		_widgets[i] = nullptr;
 	}
+	_widgetCache->clear();
 
 	for (int i = 0; i < kTextDataMAX; ++i) {
 		// Don't unload the language specific extra font here or it will be lost after a refresh() call.
@@ -960,6 +1161,13 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		extendedRect.right += drawData->_shadowOffset - drawData->_backgroundOffset;
 		extendedRect.bottom += drawData->_shadowOffset - drawData->_backgroundOffset;
 	}
+	// Rounded square shadows spill two pixels to the left of the item
+	// and one row below the dirty rectangle
+	Common::Rect itemRect = extendedRect;
+	if (drawData->_shadowOffset) {
+		itemRect.left -= 2;
+		itemRect.bottom += 1;
+	}
 
 	if (!_clip.isEmpty()) {
 		extendedRect.clip(_clip);
@@ -974,9 +1182,54 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		// Cached renderings are only used when the item is not cut by the
+		// screen borders. Items filling the whole surface must cover it.
+		// Items which are not opaque may draw around their area, shadows for
+		// example, and the whole of it is cached.
+		Graphics::ManagedSurface *surf = _vectorRenderer->getActiveSurface();
+		const Common::Rect surfRect(surf->w, surf->h);
+		bool useCache = drawData->_cached && !drawData->_steps.empty() && area == r &&
+			(!drawData->_fillsSurface || area == surfRect) &&
+			(drawData->_opaque || surfRect.contains(itemRect));
+
+		Common::Rect cachedRect = drawData->_opaque ? area : itemRect;
+		WidgetCache::Key key;
+		if (useCache) {
+			key.type = type;
+			key.dynamic = dynamic;
+			key.width = area.width();
+			key.height = area.height();
+			key.clip = _clip;
+			if (drawData->_opaque)
+				key.colors = Graphics::VectorRenderer::ColorState();
+			else
+				key.colors = _vectorRenderer->getColorState();
+			if (!key.clip.isEmpty()) {
+				cachedRect.clip(_clip);
+				key.clip.translate(-area.left, -area.top);
+			}
+
+			useCache = !cachedRect.isEmpty();
+		}
+
 		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		if (useCache && _widgetCache->draw(key, surf, cachedRect)) {
+			// Leave the renderer in the same state as if the item was drawn
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step)
+				_vectorRenderer->applyStepSettings(area, _clip, *step, dynamic);
+		} else {
+			Graphics::ManagedSurface background;
+			if (useCache && !drawData->_opaque) {
+				background.create(cachedRect.width(), cachedRect.height(), surf->format);
+				background.copyRectToSurface(*surf, 0, 0, cachedRect);
+			}
+
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+			}
+
+			if (useCache)
+				_widgetCache->store(key, surf, cachedRect, drawData->_opaque ? nullptr : &background);
 		}
 
 		addDirtyRect(extendedRect);
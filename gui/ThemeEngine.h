@@ -49,6 +49,7 @@ class VectorRenderer;
 namespace GUI {
 
 struct WidgetDrawData;
+class WidgetCache;
 struct TextDrawData;
 struct TextColorData;
 class Dialog;
@@ -729,6 +730,9 @@ protected:
 	/** Vector Renderer object, does the actual drawing on screen */
 	Graphics::VectorRenderer *_vectorRenderer;
 
+	/** Cache of rendered DrawData items, for the items the theme marks as cacheable */
+	WidgetCache *_widgetCache;
+
 	/** XML Parser, does the Theme parsing instead of the default parser */
 	GUI::ThemeParser *_parser;
 
@@ -92,10 +92,14 @@ enum {
 	kCmdSavePathClear = 'PSAC'
 };
 
+enum {
+	kPathScanTimeSlice = 10	///< Time spent checking game paths per tickle, in ms
+};
+
 #pragma mark -
 
 LauncherDialog::LauncherDialog()
-	: Dialog("Launcher") {
+	: Dialog("Launcher"), _pathScanPos(0) {
 
 	_backgroundType = GUI::ThemeEngine::kDialogBackgroundMain;
 
@@ -272,8 +276,6 @@ struct LauncherEntryComparator {
 
 void LauncherDialog::updateListing() {
 	U32StringArray l;
-	ListWidget::ColorList colors;
-	ThemeEngine::FontColor color;
 	int numEntries = ConfMan.getInt("gui_list_max_scan_entries");
 
 	// Retrieve a list of all games defined in the config file
@@ -282,7 +284,8 @@ void LauncherDialog::updateListing() {
 	bool scanEntries = numEntries == -1 ? true : ((int)domains.size() <= numEntries);
 
 	// Turn it into a list of pointers
-	Common::List<LauncherEntry> domainList;
+	Common::Array<LauncherEntry> domainList;
+	domainList.reserve(domains.size());
 	for (ConfigManager::DomainMap::const_iterator iter = domains.begin(); iter != domains.end(); ++iter) {
 		// Do not list temporary targets added when starting a game from the command line
 		if (iter->_value.contains("id_came_from_command_line"))
@@ -313,28 +316,21 @@ void LauncherDialog::updateListing() {
 	Common::sort(domainList.begin(), domainList.end(), LauncherEntryComparator());
 
 	// And fill out our structures
-	for (Common::List<LauncherEntry>::const_iterator iter = domainList.begin(); iter != domainList.end(); ++iter) {
-		color = ThemeEngine::kFontColorNormal;
-
-		if (scanEntries) {
-			Common::FSNode path(iter->domain->getVal("path"));
-			if (!path.isDirectory()) {
-				color = ThemeEngine::kFontColorAlternate;
-				// If more conditions which grey out entries are added we should consider
-				// enabling this so that it is easy to spot why a certain game entry cannot
-				// be started.
-
-				// description += Common::String::format(" (%s)", _("Not found"));
-			}
-		}
-
+	l.reserve(domainList.size());
+	_domains.reserve(domainList.size());
+	for (Common::Array<LauncherEntry>::const_iterator iter = domainList.begin(); iter != domainList.end(); ++iter) {
 		l.push_back(iter->description);
-		colors.push_back(color);
 		_domains.push_back(iter->key);
 	}
 
+	// The game paths are checked lazily, see scanGamePaths()
+	_pathScanned.clear();
+	_pathScanPos = 0;
+	if (scanEntries)
+		_pathScanned.resize(_domains.size());
+
 	const int oldSel = _list->getSelected();
-	_list->setList(l, &colors);
+	_list->setList(l);
 	if (oldSel < (int)l.size())
 		_list->setSelected(oldSel);	// Restore the old selection
 	else if (oldSel != -1)
@@ -345,6 +341,50 @@ void LauncherDialog::updateListing() {
 	// Update the filter settings, those are lost when "setList"
 	// is called.
 	_list->setFilter(_searchWidget->getEditString());
+
+	scanGamePaths(true);
+}
+
+void LauncherDialog::scanGamePaths(bool visibleOnly) {
+	if (_pathScanned.empty())
+		return;
+
+	bool changed = false;
+
+	for (int line = 0; line < _list->getNumVisibleLines(); ++line) {
+		const int item = _list->getItemOnLine(line);
+		if (item != -1 && scanGamePath(item))
+			changed = true;
+	}
+
+	if (!visibleOnly) {
+		const uint32 startTime = g_system->getMillis();
+		while (_pathScanPos < _pathScanned.size()) {
+			if (scanGamePath(_pathScanPos++))
+				changed = true;
+			if (g_system->getMillis() - startTime >= kPathScanTimeSlice)
+				break;
+		}
+	}
+
+	if (changed)
+		_list->markAsDirty();
+}
+
+bool LauncherDialog::scanGamePath(uint item) {
+	if (_pathScanned[item])
+		return false;
+	_pathScanned[item] = true;
+
+	Common::FSNode path(ConfMan.get("path", _domains[item]));
+	if (path.isDirectory())
+		return false;
+
+	// If more conditions which grey out entries are added we should consider
+	// appending a reason to the description so that it is easy to spot why a
+	// certain game entry cannot be started.
+	_list->setEntryColor(item, ThemeEngine::kFontColorAlternate);
+	return true;
 }
 
 void LauncherDialog::addGame() {
@@ -540,6 +580,11 @@ void LauncherDialog::handleKeyUp(Common::KeyState state) {
 	updateButtons();
 }
 
+void LauncherDialog::handleTickle() {
+	scanGamePaths(false);
+	Dialog::handleTickle();
+}
+
 void LauncherDialog::handleOtherEvent(const Common::Event &evt) {
 	Dialog::handleOtherEvent(evt);
 	if (evt.type == Common::EVENT_DROP_FILE) {
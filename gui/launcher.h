@@ -55,6 +55,7 @@ public:
 	void handleKeyDown(Common::KeyState state) override;
 	void handleKeyUp(Common::KeyState state) override;
 	void handleOtherEvent(const Common::Event &evt) override;
+	void handleTickle() override;
 	bool doGameDetection(const Common::String &path);
 protected:
 	EditTextWidget  *_searchWidget;
@@ -71,6 +72,8 @@ protected:
 	StaticTextWidget	*_searchDesc;
 	ButtonWidget	*_searchClearButton;
 	StringArray		_domains;
+	Common::Array<bool>	_pathScanned;	///< Whether the path of each entry has been checked
+	uint			_pathScanPos;	///< Next entry to check in the background
 	BrowserDialog	*_browser;
 	SaveLoadChooser	*_loadDialog;
 
@@ -84,6 +87,21 @@ protected:
 	 */
 	void updateListing();
 
+	/**
+	 * Grey out the entries whose game path is missing. The visible entries
+	 * are checked first, then unless visibleOnly is set, the others for
+	 * at most kPathScanTimeSlice ms.
+	 * Called on every tickle, so opening the launcher does not wait on the
+	 * filesystem for large game lists.
+	 */
+	void scanGamePaths(bool visibleOnly);
+
+	/**
+	 * Check the game path of the given entry if not done yet.
+	 * @return true if the entry has been greyed out.
+	 */
+	bool scanGamePath(uint item);
+
 	void updateButtons();
 
 	void build();
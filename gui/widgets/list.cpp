@@ -173,6 +173,12 @@ void ListWidget::setList(const U32StringArray &list, const ColorList *colors) {
 	_dataList = list;
 	_list = list;
 	_filter.clear();
+	_searchIndex.clear();
+	_searchIndex.reserve(list.size());
+	for (U32StringArray::const_iterator i = list.begin(); i != list.end(); ++i) {
+		_searchIndex.push_back(*i);
+		_searchIndex.back().toLowercase();
+	}
 	_listIndex.clear();
 	_listColors.clear();
 
@@ -192,6 +198,25 @@ void ListWidget::setList(const U32StringArray &list, const ColorList *colors) {
 	scrollBarRecalc();
 }
 
+void ListWidget::setEntryColor(int item, ThemeEngine::FontColor color) {
+	assert(item >= 0 && item < (int)_dataList.size());
+
+	if (_listColors.empty()) {
+		if (color == ThemeEngine::kFontColorNormal)
+			return;
+		// Fill up the color list with the default color first
+		_listColors.resize(_dataList.size());
+	}
+	_listColors[item] = color;
+}
+
+int ListWidget::getItemOnLine(int line) const {
+	const int pos = _currentPos + line;
+	if (line < 0 || line >= _entriesPerPage || pos < 0 || pos >= (int)_list.size())
+		return -1;
+	return _filter.empty() ? pos : _listIndex[pos];
+}
+
 void ListWidget::append(const String &s, ThemeEngine::FontColor color) {
 	if (_dataList.size() == _listColors.size()) {
 		// If the color list has the size of the data list, we append the color.
@@ -207,6 +232,8 @@ void ListWidget::append(const String &s, ThemeEngine::FontColor color) {
 
 	_dataList.push_back(s);
 	_list.push_back(s);
+	_searchIndex.push_back(s);
+	_searchIndex.back().toLowercase();
 
 	setFilter(_filter, false);
 
@@ -741,6 +768,12 @@ void ListWidget::setFilter(const U32String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	// When text is only appended to the previous filter, every entry matching
+	// the new filter also matched the old one, so only the currently listed
+	// entries need to be checked again.
+	bool narrowing = !_filter.empty() && filt.size() > _filter.size() &&
+		filt.substr(0, _filter.size()) == _filter;
+
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -752,26 +785,32 @@ void ListWidget::setFilter(const U32String &filter, bool redraw) {
 		// as substrings, ignoring case.
 
 		Common::U32StringTokenizer tok(_filter);
-		U32String tmp;
-		int n = 0;
+		Common::Array<U32String> tokens;
+		while (!tok.empty())
+			tokens.push_back(tok.nextToken());
+
+		Common::Array<int> candidates;
+		if (narrowing)
+			candidates = _listIndex;
+
+		const uint numCandidates = narrowing ? candidates.size() : _searchIndex.size();
 
 		_list.clear();
 		_listIndex.clear();
 
-		for (U32StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
+		for (uint i = 0; i < numCandidates; ++i) {
+			const int n = narrowing ? candidates[i] : i;
+			const U32String &entry = _searchIndex[n];
 			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+			for (uint t = 0; t < tokens.size(); ++t) {
+				if (!entry.contains(tokens[t])) {
 					matches = false;
 					break;
 				}
 			}
 
 			if (matches) {
-				_list.push_back(*i);
+				_list.push_back(_dataList[n]);
 				_listIndex.push_back(n);
 			}
 		}
@@ -59,6 +59,7 @@ public:
 protected:
 	U32StringArray	_list;
 	U32StringArray		_dataList;
+	U32StringArray		_searchIndex; ///< Lowercase copy of _dataList, used for filtering
 	ColorList		_listColors;
 	Common::Array<int>		_listIndex;
 	bool			_editable;
@@ -103,6 +104,9 @@ public:
 
 	void append(const String &s, ThemeEngine::FontColor color = ThemeEngine::kFontColorNormal);
 
+	/** Set the color of the entry with the given index in the data list. */
+	void setEntryColor(int item, ThemeEngine::FontColor color);
+
 	void setSelected(int item);
 	int getSelected() const						{ return (_filter.empty() || _selectedItem == -1) ? _selectedItem : _listIndex[_selectedItem]; }
 
@@ -114,6 +118,10 @@ public:
 	void scrollTo(int item);
 	void scrollToEnd();
 	int getCurrentScrollPos() const { return _currentPos; }
+	int getNumVisibleLines() const { return _entriesPerPage; }
+
+	/// Returns the data list index of the item shown on the given line, or -1 if there is none.
+	int getItemOnLine(int line) const;
 
 	void enableQuickSelect(bool enable) 		{ _quickSelect = enable; }
 	String getQuickSelectString() const 		{ return _quickSelectStr; }
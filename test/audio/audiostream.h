@@ -1,6 +1,9 @@
 #include <cxxtest/TestSuite.h>
 
 #include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+
+#include "../null_osystem.h"
 
 #include "helper.h"
 
@@ -205,4 +208,111 @@ public:
 	void test_sub_looping_audio_stream_stereo_22050_end_fixed_iter() {
 		testSubLoopingAudioStreamFixedIter(22050, true, 2, 2);
 	}
+
+private:
+	void testPooledQueuingAudioStream(const byte flags, const uint32 blockSize) {
+		Common::install_null_g_system();
+
+		const bool isStereo = (flags & Audio::FLAG_STEREO) != 0;
+		Audio::QueuingAudioStream *pooled = Audio::makePooledQueuingAudioStream(22050, isStereo, blockSize, 4);
+		Audio::QueuingAudioStream *queued = Audio::makeQueuingAudioStream(22050, isStereo);
+
+		// Queue the same packets to both streams, reusing a single buffer
+		// for the pooled stream and interleaving a regular audio stream. The
+		// packet size is a whole number of frames in every sample format
+		const uint32 packetSize = 0xF00;
+		byte packet[packetSize];
+
+		int16 pooledBuffer[1024], queuedBuffer[1024];
+		for (int i = 0; i < 64; i++) {
+			for (uint32 j = 0; j < packetSize; j++)
+				packet[j] = (byte)(i * 7 + j * 13);
+
+			byte *copy = (byte *)malloc(packetSize);
+			memcpy(copy, packet, packetSize);
+
+			pooled->queueBuffer(packet, packetSize, DisposeAfterUse::NO, flags);
+			queued->queueBuffer(copy, packetSize, DisposeAfterUse::YES, flags);
+
+			if (i % 8 == 0) {
+				pooled->queueAudioStream(createSineStream<int16>(22050, 1, nullptr, false, isStereo));
+				queued->queueAudioStream(createSineStream<int16>(22050, 1, nullptr, false, isStereo));
+			}
+
+			// Keep some data queued, and make the pool wrap around
+			if (i >= 2) {
+				TS_ASSERT_EQUALS(pooled->readBuffer(pooledBuffer, 1024), queued->readBuffer(queuedBuffer, 1024));
+				TS_ASSERT_EQUALS(memcmp(pooledBuffer, queuedBuffer, sizeof(pooledBuffer)), 0);
+			}
+		}
+
+		pooled->finish();
+		queued->finish();
+
+		while (!queued->endOfStream()) {
+			const int samples = queued->readBuffer(queuedBuffer, 1024);
+			TS_ASSERT_EQUALS(pooled->readBuffer(pooledBuffer, 1024), samples);
+			TS_ASSERT_EQUALS(memcmp(pooledBuffer, queuedBuffer, samples * sizeof(int16)), 0);
+		}
+
+		TS_ASSERT(pooled->endOfStream());
+		TS_ASSERT_EQUALS(pooled->numQueuedStreams(), 0u);
+
+		delete pooled;
+		delete queued;
+	}
+
+	uint32 queuePacketsPerSecond(Audio::QueuingAudioStream *stream, bool pooled) {
+		// Queue and play packets of the size the SMUSH player uses, each
+		// one allocated by the caller for the regular stream
+		const uint32 packetSize = 0x1000;
+		const int count = 1 << 16;
+		byte packet[packetSize];
+		memset(packet, 0, packetSize);
+
+		int16 buffer[packetSize / 2];
+		const uint32 start = g_system->getMillis();
+		for (int i = 0; i < count; i++) {
+			if (pooled) {
+				stream->queueBuffer(packet, packetSize, DisposeAfterUse::NO, Audio::FLAG_16BITS | Audio::FLAG_STEREO);
+			} else {
+				byte *copy = (byte *)malloc(packetSize);
+				memcpy(copy, packet, packetSize);
+				stream->queueBuffer(copy, packetSize, DisposeAfterUse::YES, Audio::FLAG_16BITS | Audio::FLAG_STEREO);
+			}
+			TS_ASSERT_EQUALS(stream->readBuffer(buffer, packetSize / 2), (int)packetSize / 2);
+		}
+		const uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+		delete stream;
+		return (uint32)((uint64)count * 1000 / time);
+	}
+
+public:
+	void test_pooled_queuing_audio_stream_8_bit_unsigned_mono() {
+		testPooledQueuingAudioStream(Audio::FLAG_UNSIGNED, 0x1000);
+	}
+
+	void test_pooled_queuing_audio_stream_16_bit_le_stereo() {
+		testPooledQueuingAudioStream(Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | Audio::FLAG_STEREO, 0x1000);
+	}
+
+	void test_pooled_queuing_audio_stream_split_blocks() {
+		// Blocks which do not hold a whole number of sample frames
+		testPooledQueuingAudioStream(Audio::FLAG_16BITS | Audio::FLAG_STEREO, 0x3FF);
+	}
+
+	void test_pooled_queuing_audio_stream_24_bit() {
+		testPooledQueuingAudioStream(Audio::FLAG_24BITS | Audio::FLAG_UNSIGNED, 0x1000);
+	}
+
+	void test_pooled_queuing_audio_stream_benchmark() {
+		Common::install_null_g_system();
+
+		const uint32 queued = queuePacketsPerSecond(Audio::makeQueuingAudioStream(22050, true), false);
+		const uint32 pooled = queuePacketsPerSecond(Audio::makePooledQueuingAudioStream(22050, true, 0x1000, 4), true);
+
+		TS_TRACE(Common::String::format("Regular queue: %u packets per second", queued).c_str());
+		TS_TRACE(Common::String::format("Pooled queue: %u packets per second", pooled).c_str());
+	}
 };
@@ -0,0 +1,124 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/soundcache.h"
+
+#include "../null_osystem.h"
+#include "helper.h"
+
+class SoundCacheTestSuite : public CxxTest::TestSuite
+{
+public:
+	void test_decode_once() {
+		Common::install_null_g_system();
+		Audio::SoundCache cache;
+
+		int16 *sine;
+		Audio::SeekableAudioStream *s = cache.get("archive", "sound", 0);
+		TS_ASSERT(!s);
+		s = cache.add("archive", "sound", 0, createSineStream<int16>(11025, 1, &sine, false, true));
+		TS_ASSERT(s);
+		TS_ASSERT_EQUALS(cache.getSize(), 11025u * 2 * sizeof(int16));
+
+		// Two streams play the same data independently
+		Audio::SeekableAudioStream *s2 = cache.get("ARCHIVE", "Sound", 0);
+		TS_ASSERT(s2);
+		TS_ASSERT(s2->isStereo());
+		TS_ASSERT_EQUALS(s2->getRate(), 11025);
+		TS_ASSERT_EQUALS(s2->getLength().totalNumberOfFrames(), 11025);
+
+		const int totalSamples = 11025 * 2;
+		int16 *buffer = new int16[totalSamples];
+		TS_ASSERT_EQUALS(s->readBuffer(buffer, 100), 100);
+		TS_ASSERT_EQUALS(s2->readBuffer(buffer, totalSamples), totalSamples);
+		TS_ASSERT_EQUALS(memcmp(sine, buffer, sizeof(int16) * totalSamples), 0);
+		TS_ASSERT(s2->endOfData());
+		TS_ASSERT(!s->endOfData());
+
+		TS_ASSERT(s2->rewind());
+		TS_ASSERT_EQUALS(s2->readBuffer(buffer, totalSamples), totalSamples);
+		TS_ASSERT_EQUALS(memcmp(sine, buffer, sizeof(int16) * totalSamples), 0);
+
+		TS_ASSERT(!cache.get("archive", "sound", 4));
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+		TS_ASSERT_EQUALS(cache.getMisses(), 2u);
+
+		delete s;
+		delete s2;
+		delete[] buffer;
+		delete[] sine;
+	}
+
+	void test_budget() {
+		Common::install_null_g_system();
+
+		// Room for two one second mono sounds
+		const uint32 soundSize = 11025 * sizeof(int16);
+		Audio::SoundCache cache(soundSize * 2);
+
+		delete cache.add("archive", "a", 0, createSineStream<int16>(11025, 1, nullptr, false, false));
+		delete cache.add("archive", "b", 0, createSineStream<int16>(11025, 1, nullptr, false, false));
+
+		// Touch "a", so that "b" is the least recently used sound
+		Audio::SeekableAudioStream *a = cache.get("archive", "a", 0);
+		TS_ASSERT(a);
+
+		delete cache.add("archive", "c", 0, createSineStream<int16>(11025, 1, nullptr, false, false));
+		TS_ASSERT_EQUALS(cache.getSize(), soundSize * 2);
+
+		Audio::SeekableAudioStream *b = cache.get("archive", "b", 0);
+		TS_ASSERT(!b);
+		Audio::SeekableAudioStream *c = cache.get("archive", "c", 0);
+		TS_ASSERT(c);
+
+		// Dropped sounds remain playable until their stream is deleted
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(!cache.get("archive", "a", 0));
+
+		int16 buffer[16];
+		TS_ASSERT_EQUALS(a->readBuffer(buffer, 16), 16);
+		TS_ASSERT_EQUALS(c->readBuffer(buffer, 16), 16);
+
+		delete a;
+		delete c;
+
+		// Sounds larger than the budget are not kept
+		cache.setBudget(soundSize / 2);
+		Audio::SeekableAudioStream *big = cache.add("archive", "big", 0, createSineStream<int16>(11025, 1, nullptr, false, false));
+		TS_ASSERT(big);
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT_EQUALS(big->getLength().totalNumberOfFrames(), 11025);
+		delete big;
+	}
+
+	void test_streams_outlive_cache() {
+		Common::install_null_g_system();
+
+		const uint32 soundSize = 11025 * sizeof(int16);
+		Audio::SoundCache *cache = new Audio::SoundCache(soundSize * 2);
+
+		// A cached sound, a replaced one, a dropped one and one over budget
+		Audio::SeekableAudioStream *cached = cache->add("archive", "a", 0, createSineStream<int16>(11025, 1, nullptr, false, false));
+		Audio::SeekableAudioStream *replaced = cache->add("archive", "b", 0, createSineStream<int16>(11025, 1, nullptr, false, false));
+		delete cache->add("archive", "b", 0, createSineStream<int16>(11025, 1, nullptr, false, false));
+		Audio::SeekableAudioStream *dropped = cache->get("archive", "b", 0);
+		cache->clear();
+		delete cache->add("archive", "a", 0, createSineStream<int16>(11025, 1, nullptr, false, false));
+		Audio::SeekableAudioStream *big = cache->add("archive", "big", 0, createSineStream<int16>(11025 * 4, 1, nullptr, false, false));
+		TS_ASSERT(cached && replaced && dropped && big);
+
+		delete cache;
+
+		int16 buffer[16];
+		TS_ASSERT_EQUALS(cached->readBuffer(buffer, 16), 16);
+		TS_ASSERT_EQUALS(replaced->readBuffer(buffer, 16), 16);
+		TS_ASSERT_EQUALS(dropped->readBuffer(buffer, 16), 16);
+		TS_ASSERT_EQUALS(big->readBuffer(buffer, 16), 16);
+
+		delete cached;
+		delete replaced;
+		delete dropped;
+		delete big;
+	}
+};
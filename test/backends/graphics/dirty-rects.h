@@ -0,0 +1,108 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/graphics/dirty-rects.h"
+
+class DirtyRectsTestSuite : public CxxTest::TestSuite
+{
+	struct TestRect {
+		int x, y, w, h;
+	};
+
+	enum {
+		kMaxRects = 4,
+		kRectCost = 16
+	};
+
+	TestRect _list[kMaxRects];
+	int _numRects;
+
+	static TestRect makeRect(int x, int y, int w, int h) {
+		TestRect r;
+		r.x = x;
+		r.y = y;
+		r.w = w;
+		r.h = h;
+		return r;
+	}
+
+	void add(int x, int y, int w, int h) {
+		addDirtyRectToList(_list, _numRects, (int)kMaxRects, (int)kRectCost, makeRect(x, y, w, h));
+	}
+
+	bool covered(int x, int y) const {
+		for (int i = 0; i < _numRects; ++i) {
+			if (x >= _list[i].x && x < _list[i].x + _list[i].w && y >= _list[i].y && y < _list[i].y + _list[i].h)
+				return true;
+		}
+		return false;
+	}
+
+	public:
+	void setUp() {
+		_numRects = 0;
+	}
+
+	void test_separate() {
+		add(0, 0, 10, 10);
+		add(50, 50, 10, 10);
+		TS_ASSERT_EQUALS(_numRects, 2);
+	}
+
+	void test_overlapping() {
+		add(0, 0, 10, 10);
+		add(5, 0, 10, 10);
+		TS_ASSERT_EQUALS(_numRects, 1);
+		TS_ASSERT_EQUALS(_list[0].x, 0);
+		TS_ASSERT_EQUALS(_list[0].y, 0);
+		TS_ASSERT_EQUALS(_list[0].w, 15);
+		TS_ASSERT_EQUALS(_list[0].h, 10);
+	}
+
+	void test_contained() {
+		add(0, 0, 20, 20);
+		add(5, 5, 5, 5);
+		TS_ASSERT_EQUALS(_numRects, 1);
+		TS_ASSERT_EQUALS(_list[0].w, 20);
+		TS_ASSERT_EQUALS(_list[0].h, 20);
+
+		add(30, 30, 2, 2);
+		add(20, 20, 20, 20);
+		TS_ASSERT_EQUALS(_numRects, 2);
+	}
+
+	void test_chained() {
+		// The bridging rect merges with both, then the result with the other one
+		add(0, 0, 10, 10);
+		add(20, 0, 10, 10);
+		TS_ASSERT_EQUALS(_numRects, 2);
+		add(8, 0, 14, 10);
+		TS_ASSERT_EQUALS(_numRects, 1);
+		TS_ASSERT_EQUALS(_list[0].x, 0);
+		TS_ASSERT_EQUALS(_list[0].w, 30);
+	}
+
+	void test_full_list() {
+		for (int i = 0; i < 10; ++i)
+			add(i * 100, i * 100, 10, 10);
+
+		TS_ASSERT_EQUALS(_numRects, (int)kMaxRects);
+		for (int i = 0; i < 10; ++i) {
+			TS_ASSERT(covered(i * 100, i * 100));
+			TS_ASSERT(covered(i * 100 + 9, i * 100 + 9));
+		}
+	}
+
+	void test_full_screen() {
+		// Rects merging into one covering the whole screen leave only that rect
+		add(0, 0, 320, 100);
+		add(10, 250, 10, 10);
+		add(0, 100, 320, 100);
+		TS_ASSERT_EQUALS(_numRects, 2);
+		add(0, 200, 320, 100);
+		TS_ASSERT_EQUALS(_numRects, 1);
+		TS_ASSERT_EQUALS(_list[0].x, 0);
+		TS_ASSERT_EQUALS(_list[0].y, 0);
+		TS_ASSERT_EQUALS(_list[0].w, 320);
+		TS_ASSERT_EQUALS(_list[0].h, 300);
+	}
+};
@@ -255,4 +255,46 @@ public:
 		tmpl_align_16<Common::MemoryReadStream, Common::BitStream16BELSB>();
 		tmpl_align_16<Common::BitStreamMemoryStream, Common::BitStreamMemory16BELSB>();
 	}
+private:
+	template<class MS, class BS>
+	void tmpl_layout(uint32 v0, uint32 v1, uint32 v2, uint32 v3, uint32 v4) {
+		byte contents[] = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0, 0x0f, 0xed, 0xcb, 0xa9 };
+
+		MS ms(contents, sizeof(contents));
+
+		BS bs(ms);
+		TS_ASSERT_EQUALS(bs.getBits(5), v0);
+		TS_ASSERT_EQUALS(bs.getBits(20), v1);
+		TS_ASSERT_EQUALS(bs.peekBits(32), v2);
+		TS_ASSERT_EQUALS(bs.getBits(32), v2);
+		TS_ASSERT_EQUALS(bs.getBits(32), v3);
+		TS_ASSERT_EQUALS(bs.pos(), 89u);
+		TS_ASSERT(!bs.eos());
+		TS_ASSERT_EQUALS(bs.getBits(7), v4);
+		TS_ASSERT(bs.eos());
+	}
+public:
+	void test_layouts() {
+		tmpl_layout<Common::MemoryReadStream, Common::BitStream8MSB>(0x2, 0x468ac, 0xf13579bd, 0xe01fdb97, 0x29);
+		tmpl_layout<Common::BitStreamMemoryStream, Common::BitStreamMemory8MSB>(0x2, 0x468ac, 0xf13579bd, 0xe01fdb97, 0x29);
+		tmpl_layout<Common::MemoryReadStream, Common::BitStream8LSB>(0x12, 0x2b1a0, 0x6f5e4d3c, 0xe5f687f8, 0x54);
+		tmpl_layout<Common::BitStreamMemoryStream, Common::BitStreamMemory8LSB>(0x12, 0x2b1a0, 0x6f5e4d3c, 0xe5f687f8, 0x54);
+		tmpl_layout<Common::MemoryReadStream, Common::BitStream16LEMSB>(0x6, 0x824f0, 0xad7935e1, 0xbdda1f53, 0x4b);
+		tmpl_layout<Common::BitStreamMemoryStream, Common::BitStreamMemory16LEMSB>(0x6, 0x824f0, 0xad7935e1, 0xbdda1f53, 0x4b);
+		tmpl_layout<Common::MemoryReadStream, Common::BitStream16BELSB>(0x14, 0x3c091, 0x784d5e2b, 0xd487f6ef, 0x65);
+		tmpl_layout<Common::BitStreamMemoryStream, Common::BitStreamMemory16BELSB>(0x14, 0x3c091, 0x784d5e2b, 0xd487f6ef, 0x65);
+		tmpl_layout<Common::MemoryReadStream, Common::BitStream32LEMSB>(0xf, 0xac68, 0x25e1bd79, 0x355397da, 0xf);
+		tmpl_layout<Common::BitStreamMemoryStream, Common::BitStreamMemory32LEMSB>(0xf, 0xac68, 0x25e1bd79, 0x355397da, 0xf);
+		tmpl_layout<Common::MemoryReadStream, Common::BitStream32BELSB>(0x18, 0x1a2b3, 0x5e6f7809, 0xf6e5d4cd, 0x7);
+		tmpl_layout<Common::BitStreamMemoryStream, Common::BitStreamMemory32BELSB>(0x18, 0x1a2b3, 0x5e6f7809, 0xf6e5d4cd, 0x7);
+	}
+
+	void test_memory_stream_read_be() {
+		byte contents[] = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc };
+
+		Common::BitStreamMemoryStream ms(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(ms.readUint16BE(), 0x1234);
+		TS_ASSERT_EQUALS(ms.readUint32BE(), 0x56789abcu);
+		TS_ASSERT(!ms.eos());
+	}
 };
@@ -0,0 +1,218 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/dct.h"
+#include "common/fft.h"
+#include "common/mdct.h"
+#include "common/rdft.h"
+#include "common/str.h"
+#include "common/system.h"
+#include "common/util.h"
+
+#include "../null_osystem.h"
+
+/**
+ * Checks the split-radix transforms against straightforward O(n^2)
+ * reference implementations computed in double precision.
+ */
+class FFTTestSuite : public CxxTest::TestSuite {
+	// Pseudo-random input in [-0.5, 0.5), independent of rand()
+	static float randomSample(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return ((seed >> 8) & 0xFFFF) / 65536.0f - 0.5f;
+	}
+
+	// The error grows with the transform size, allow for that
+	static double maxError(int n) {
+		return 1e-6 * n;
+	}
+
+	static void checkFFT(int bits, int inverse) {
+		const int n = 1 << bits;
+		const double sign = inverse ? 1.0 : -1.0;
+
+		Common::Complex *in = new Common::Complex[n];
+		Common::Complex *z = new Common::Complex[n];
+
+		uint32 seed = bits;
+		for (int i = 0; i < n; i++) {
+			in[i].re = randomSample(seed);
+			in[i].im = randomSample(seed);
+			z[i] = in[i];
+		}
+
+		Common::FFT fft(bits, inverse);
+		fft.permute(z);
+		fft.calc(z);
+
+		for (int k = 0; k < n; k++) {
+			double re = 0.0, im = 0.0;
+			for (int j = 0; j < n; j++) {
+				const double a = sign * 2.0 * M_PI * ((j * k) & (n - 1)) / n;
+				re += in[j].re * cos(a) - in[j].im * sin(a);
+				im += in[j].im * cos(a) + in[j].re * sin(a);
+			}
+			TS_ASSERT_DELTA(z[k].re, re, maxError(n));
+			TS_ASSERT_DELTA(z[k].im, im, maxError(n));
+		}
+
+		delete[] z;
+		delete[] in;
+	}
+
+public:
+	void test_fft() {
+		for (int bits = 2; bits <= 11; bits++) {
+			checkFFT(bits, 0);
+			checkFFT(bits, 1);
+		}
+	}
+
+	void test_rdft() {
+		for (int bits = 4; bits <= 11; bits++) {
+			const int n = 1 << bits;
+
+			float *in = new float[n];
+			float *data = new float[n];
+
+			uint32 seed = bits;
+			for (int i = 0; i < n; i++)
+				data[i] = in[i] = randomSample(seed);
+
+			Common::RDFT rdft(bits, Common::RDFT::DFT_R2C);
+			rdft.calc(data);
+
+			// data[0] holds X[0], data[1] holds X[n/2], then re/im pairs
+			double nyquist = 0.0;
+			for (int j = 0; j < n; j++)
+				nyquist += (j & 1) ? -in[j] : in[j];
+			TS_ASSERT_DELTA(data[1], nyquist, maxError(n));
+
+			for (int k = 0; k < n / 2; k++) {
+				double re = 0.0, im = 0.0;
+				for (int j = 0; j < n; j++) {
+					const double a = 2.0 * M_PI * ((j * k) & (n - 1)) / n;
+					re += in[j] * cos(a);
+					im -= in[j] * sin(a);
+				}
+				TS_ASSERT_DELTA(data[2 * k], re, maxError(n));
+				if (k > 0)
+					TS_ASSERT_DELTA(data[2 * k + 1], im, maxError(n));
+			}
+
+			// The inverse transform scales by n / 2
+			Common::RDFT irdft(bits, Common::RDFT::IDFT_C2R);
+			irdft.calc(data);
+
+			for (int i = 0; i < n; i++)
+				TS_ASSERT_DELTA(data[i] * 2.0 / n, in[i], maxError(n));
+
+			delete[] data;
+			delete[] in;
+		}
+	}
+
+	void test_dct() {
+		for (int bits = 4; bits <= 10; bits++) {
+			const int n = 1 << bits;
+
+			float *in = new float[n];
+			float *data = new float[n];
+
+			uint32 seed = bits;
+			for (int i = 0; i < n; i++)
+				data[i] = in[i] = randomSample(seed);
+
+			Common::DCT dct2(bits, Common::DCT::DCT_II);
+			dct2.calc(data);
+
+			for (int k = 0; k < n; k++) {
+				double sum = 0.0;
+				for (int j = 0; j < n; j++)
+					sum += in[j] * cos(M_PI / n * (j + 0.5) * k);
+				TS_ASSERT_DELTA(data[k], sum, maxError(n));
+			}
+
+			for (int i = 0; i < n; i++)
+				data[i] = in[i];
+
+			// DCT-III output is scaled by 2 / n
+			Common::DCT dct3(bits, Common::DCT::DCT_III);
+			dct3.calc(data);
+
+			for (int k = 0; k < n; k++) {
+				double sum = in[0] * 0.5;
+				for (int j = 1; j < n; j++)
+					sum += in[j] * cos(M_PI / n * (k + 0.5) * j);
+				TS_ASSERT_DELTA(data[k], sum * 2.0 / n, maxError(n));
+			}
+
+			delete[] data;
+			delete[] in;
+		}
+	}
+
+	void test_imdct() {
+		for (int bits = 6; bits <= 12; bits++) {
+			const int n = 1 << bits;
+
+			float *in = new float[n / 2];
+			float *out = new float[n];
+
+			uint32 seed = bits;
+			for (int i = 0; i < n / 2; i++)
+				in[i] = randomSample(seed);
+
+			Common::MDCT mdct(bits, true, 1.0);
+			mdct.calcIMDCT(out, in);
+
+			for (int j = 0; j < n; j++) {
+				double sum = 0.0;
+				for (int k = 0; k < n / 2; k++)
+					sum += in[k] * cos(2.0 * M_PI / n * (j + 0.5 + n / 4.0) * (k + 0.5));
+				TS_ASSERT_DELTA(out[j], -sum, maxError(n));
+			}
+
+			delete[] out;
+			delete[] in;
+		}
+	}
+
+	void test_fft_benchmark() {
+		Common::install_null_g_system();
+
+		// Time forward and inverse transforms of the sizes the audio decoders use
+		for (int bits = 7; bits <= 11; bits++) {
+			const int n = 1 << bits;
+			const int count = (1 << 20) / n;
+
+			Common::Complex *z = new Common::Complex[n];
+			for (int i = 0; i < n; i++)
+				z[i].re = z[i].im = 0.0f;
+			z[1].re = 1.0f;
+
+			Common::FFT fft(bits, 0);
+			Common::FFT ifft(bits, 1);
+
+			const uint32 start = g_system->getMillis();
+			for (int iter = 0; iter < count; iter++) {
+				fft.permute(z);
+				fft.calc(z);
+				ifft.permute(z);
+				ifft.calc(z);
+
+				for (int i = 0; i < n; i++) {
+					z[i].re /= n;
+					z[i].im /= n;
+				}
+			}
+			const uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			TS_TRACE(Common::String::format("%d points: %u transforms per second", n, 2 * count * 1000 / time).c_str());
+
+			TS_ASSERT_DELTA(z[1].re, 1.0f, maxError(n));
+			TS_ASSERT_DELTA(z[0].re, 0.0f, maxError(n));
+
+			delete[] z;
+		}
+	}
+};
@@ -2,6 +2,10 @@
 #include "common/huffman.h"
 #include "common/bitstream.h"
 #include "common/memstream.h"
+#include "common/str.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
 
 /**
 * A test suite for the Huffman decoder in common/huffman.h
@@ -94,4 +98,95 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	template<class BS>
+	void tmpl_long_codes(bool msb2lsb) {
+		/*
+		 * A code with a long tail, needing several levels of lookup tables:
+		 * symbol i < 19 is i ones followed by a zero, symbol 19 is 19 ones.
+		 * The input is generated by writing the codes of the symbols.
+		 */
+
+		const uint32 codeCount = 20;
+		uint8 lengths[codeCount];
+		uint32 codes[codeCount];
+
+		for (uint32 i = 0; i < codeCount; i++) {
+			lengths[i] = MIN<uint32>(i + 1, 19);
+			if (i == 19)
+				codes[i] = (1 << 19) - 1;
+			else
+				codes[i] = msb2lsb ? ((1 << i) - 1) << 1 : (1 << i) - 1;
+		}
+
+		Common::Huffman<BS> h(0, codeCount, codes, lengths);
+
+		const uint32 expected[] = {19, 0, 18, 5, 9, 12, 1, 17, 8, 3, 19, 19, 7, 0, 11, 2};
+		const uint32 expectedCount = ARRAYSIZE(expected);
+
+		byte input[32];
+		memset(input, 0, sizeof(input));
+
+		uint32 pos = 0;
+		for (uint32 i = 0; i < expectedCount; i++) {
+			for (uint32 j = 0; j < lengths[expected[i]]; j++, pos++) {
+				uint bit = (expected[i] == 19 || j < expected[i]) ? 1 : 0;
+				input[pos / 8] |= bit << (msb2lsb ? 7 - (pos % 8) : pos % 8);
+			}
+		}
+		TS_ASSERT(pos <= sizeof(input) * 8);
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		BS bs(ms);
+
+		for (uint32 i = 0; i < expectedCount; i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), expected[i]);
+		TS_ASSERT_EQUALS(bs.pos(), pos);
+	}
+
+	void test_long_codes() {
+		tmpl_long_codes<Common::BitStream8MSB>(true);
+		tmpl_long_codes<Common::BitStream8LSB>(false);
+		tmpl_long_codes<Common::BitStream32LELSB>(false);
+	}
+
+	void test_long_codes_benchmark() {
+		Common::install_null_g_system();
+
+		// Decode many long codes, to time the sub-table lookups
+		const uint32 codeCount = 20;
+		uint8 lengths[codeCount];
+		uint32 codes[codeCount];
+
+		for (uint32 i = 0; i < codeCount; i++) {
+			lengths[i] = MIN<uint32>(i + 1, 19);
+			codes[i] = (i == 19) ? (1 << 19) - 1 : ((1 << i) - 1) << 1;
+		}
+
+		Common::Huffman<Common::BitStreamMemory8MSB> h(0, codeCount, codes, lengths);
+
+		// All ones: a stream of symbol 19
+		const uint32 inputSize = 19 * 65536;
+		byte *input = (byte *)malloc(inputSize);
+		memset(input, 0xFF, inputSize);
+
+		Common::BitStreamMemoryStream ms(input, inputSize);
+		Common::BitStreamMemory8MSB bs(ms);
+
+		uint32 count = 0;
+		bool valid = true;
+		const uint32 start = g_system->getMillis();
+		while (bs.pos() + 19 <= bs.size()) {
+			valid &= h.getSymbol(bs) == 19;
+			count++;
+		}
+		const uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+		TS_TRACE(Common::String::format("19 bit codes: %u decodes per second", (uint32)((uint64)count * 1000 / time)).c_str());
+
+		TS_ASSERT(valid);
+		TS_ASSERT_EQUALS(count, 8u * 65536);
+
+		free(input);
+	}
 };